@@ -1,17 +1,16 @@
 #include "Apple.h"
 
 
-Apple::Apple(Object* dependant_, int value_) : dependant(dependant_), value(value_)
+Apple::Apple(ObjectHandle dependant_, int value_) : dependant(dependant_), value(value_)
 {
+    //the highlight only changes when the selection box starts or stops touching
+    SetCollisionEvents(COLLISION_EVENT_ENTER | COLLISION_EVENT_EXIT);
 }
 
 void Apple::Init(const EngineContext& engineContext)
 {
+    //mesh, material, collider and collision group come from Level1's apple prefab
     this->engineContext = &engineContext;
-    SetMesh(engineContext, "default");
-    SetSelected(false);
-    SetCollider(std::make_unique<AABBCollider>(this, glm::vec2(0.9, 0.9))); 
-    SetCollision(engineContext.stateManager->GetCurrentState()->GetObjectManager(), "apple", { "player_selection" });
     vel = { 0,0 };
 }
 
@@ -21,13 +20,13 @@ void Apple::LateInit(const EngineContext& engineContext)
 
 void Apple::Update(float dt, const EngineContext& engineContext)
 {
-    SetSelected(false);
     if (dead_timer.IsStarted())
     {
         glm::vec2 prev = GetTransform2D().GetPosition();
         vel.y += -980.f *1.5f * dt;
         GetTransform2D().SetPosition(prev + vel * dt);
-        dependant->GetTransform2D().SetPosition(GetTransform2D().GetPosition());
+        if (Object* text = engineContext.stateManager->GetCurrentState()->GetObjectManager().Get(dependant))
+            text->GetTransform2D().SetPosition(GetTransform2D().GetPosition());
         dead_timer.Update(dt);
 
         if (dead_timer.IsTimedOut())
@@ -35,6 +34,11 @@ void Apple::Update(float dt, const EngineContext& engineContext)
             Kill();
         }
     }
+    else
+    {
+        //idle until the selection box touches it again
+        Sleep();
+    }
 }
 
 void Apple::Draw(const EngineContext& engineContext)
@@ -43,14 +47,15 @@ void Apple::Draw(const EngineContext& engineContext)
 
 void Apple::Free(const EngineContext& engineContext)
 {
-    dependant->Kill();
+    if (Object* text = engineContext.stateManager->GetCurrentState()->GetObjectManager().Get(dependant))
+        text->Kill();
 }
 
 void Apple::LateFree(const EngineContext& engineContext)
 {
 }
 
-void Apple::OnCollision(Object* other)
+void Apple::OnCollisionEnter(Object* other)
 {
     if (dead_timer.IsStarted()) return;
 
@@ -60,6 +65,16 @@ void Apple::OnCollision(Object* other)
     }
 }
 
+void Apple::OnCollisionExit(Object* other)
+{
+    if (dead_timer.IsStarted()) return;
+
+    if (other->GetTag() == "player_controller")
+    {
+        SetSelected(false);
+    }
+}
+
 const int& Apple::GetValue() const
 {
     return value;
@@ -69,11 +84,11 @@ void Apple::SetSelected(bool bSelected)
 {
     if (bSelected)
     {
-        SetMaterial(*engineContext, "m_apple_highlighted");
+        SetMaterial(*engineContext, "m_apple_highlighted"_sid);
     }
     else
     {
-        SetMaterial(*engineContext, "m_apple");
+        SetMaterial(*engineContext, "m_apple"_sid);
     }
 }
 
@@ -83,5 +98,6 @@ void Apple::SetVelocityAndStartDeadTimer(const glm::vec2& vel)
         return;
     this->vel = vel;
     dead_timer.Start(2.0f);
-    collider.release();
+    WakeUp();
+    SetCollider(nullptr);
 }
@@ -81,13 +81,6 @@ void ApplePlayerController::LateFree(const EngineContext& engineContext)
 {
 }
 
-void ApplePlayerController::OnCollision(Object* other)
-{
-    if (!checkApples) return;
-    
-    selectedObjects.push_back(other);
-}
-
 void ApplePlayerController::StartDragging(const EngineContext& engineContext)
 {
     SNAKE_LOG("[ApplePlayerController]  StartDragging");
@@ -104,8 +97,15 @@ void ApplePlayerController::EndDragging(const EngineContext& engineContext)
 {
     SNAKE_LOG("[ApplePlayerController]  EndDragging");
     SetVisibility(false);
-    checkApples = true;
+
+    //ask for the apples under the box right away instead of waiting for next frame's collisions
+    const glm::vec2 center = GetTransform2D().GetPosition();
+    const glm::vec2 half = glm::abs(GetTransform2D().GetScale()) * 0.5f;
     selectedObjects.clear();
+    engineContext.stateManager->GetCurrentState()->GetObjectManager().QueryAABB(center - half, center + half, selectedObjects, GetCollisionMask());
+
+    checkApples = true;
+    CheckSelectedApples(engineContext);
 }
 
 void ApplePlayerController::DoNothing(const EngineContext& engineContext)
@@ -11,7 +11,6 @@ public:
     void Draw(const EngineContext& engineContext) override;
     void Free(const EngineContext& engineContext) override;
     void LateFree(const EngineContext& engineContext) override;
-    void OnCollision(Object* other) override;
 
     glm::vec2 ConvertScreenToCamera(Camera2D* cam, const glm::vec2& screen_pos);
     int GetScore() const;
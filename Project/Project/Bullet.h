@@ -12,7 +12,11 @@ public:
     void Draw(const EngineContext& engineContext) override;
     void Free(const EngineContext& engineContext) override;
     void LateFree(const EngineContext& engineContext) override;
+    void OnAcquire() override;
+    void Launch(glm::vec2 pos, glm::vec2 _dir);
 private:
+    void ResetSpawnState();
+
     glm::vec2 dir;
     float timer = 0;
     float rotAmount = 0;
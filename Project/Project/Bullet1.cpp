@@ -16,32 +16,10 @@ void Bullet1::Init(const EngineContext& engineContext)
     SetMesh(engineContext, "default");
     SetMaterial(engineContext, "m_instancing1");
     SetRenderLayer("Bullet");
+    SetThreadSafeUpdate(true);
     GetMaterial()->EnableInstancing(true, GetMesh());
     AttachAnimator(engineContext.renderManager->GetSpriteSheetByTag("animTest1"), 0.08f);
-    spriteAnimator->PlayClip(0, 3);
-
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<float> scaleDist(40.0f, 40.0f);
-    float scale = scaleDist(gen);
-
-
-    std::uniform_real_distribution<float> rDist(0.5f, 1.0f);  
-    std::uniform_real_distribution<float> gDist(0.5f, 1.0f);  
-    std::uniform_real_distribution<float> bDist(0.5f, 1.0f);  
-    std::uniform_real_distribution<float> aDist(0.3f, 0.7f);
-    std::uniform_real_distribution<float> rotDist(-5.f, 5.f);
-    std::uniform_real_distribution<float> speedDist(100.f, 150.f);
-
-    float a = aDist(gen);
-    float r = rDist(gen);
-    float g = gDist(gen);
-    float b = bDist(gen);
-    speed = speedDist(gen);
-    color = glm::vec4(r, g, b, a);
-    rotAmount = rotDist(gen);
-
-    transform2D.SetScale(glm::vec2(scale));
+    ResetSpawnState();
 }
 
 void Bullet1::LateInit(const EngineContext& engineContext)
@@ -71,3 +49,43 @@ void Bullet1::LateFree(const EngineContext& engineContext)
 {
     SNAKE_LOG("Bullet LateFree Called");
 }
+
+void Bullet1::OnAcquire()
+{
+    timer = 0;
+    ResetSpawnState();
+}
+
+void Bullet1::Launch(glm::vec2 pos, glm::vec2 _dir)
+{
+    transform2D.SetPosition(pos);
+    dir = _dir;
+}
+
+void Bullet1::ResetSpawnState()
+{
+    spriteAnimator->PlayClip(0, 3);
+
+    static std::random_device rd;
+    static std::mt19937 gen(rd());
+    static std::uniform_real_distribution<float> scaleDist(40.0f, 40.0f);
+    float scale = scaleDist(gen);
+
+
+    std::uniform_real_distribution<float> rDist(0.5f, 1.0f);  
+    std::uniform_real_distribution<float> gDist(0.5f, 1.0f);  
+    std::uniform_real_distribution<float> bDist(0.5f, 1.0f);  
+    std::uniform_real_distribution<float> aDist(0.3f, 0.7f);
+    std::uniform_real_distribution<float> rotDist(-5.f, 5.f);
+    std::uniform_real_distribution<float> speedDist(100.f, 150.f);
+
+    float a = aDist(gen);
+    float r = rDist(gen);
+    float g = gDist(gen);
+    float b = bDist(gen);
+    speed = speedDist(gen);
+    SetColor(glm::vec4(r, g, b, a));
+    rotAmount = rotDist(gen);
+
+    transform2D.SetScale(glm::vec2(scale));
+}
@@ -23,7 +23,7 @@ void Enemy::Init(const EngineContext& engineContext)
     sheet->AddClip("backwalk", { 80,81,82,83,84,85 }, 0.08f, true);
     sheet->AddClip("idle", { 9 }, 0.08f, false);
     AttachAnimator(sheet, 0.08f);
-    spriteAnimator->PlayClip("idle");
+    spriteAnimator->PlayClip("idle"_sid);
 
     SetRenderLayer("Penguin");
     SetColor({ 0.6,0.2,0.2,1 });
@@ -33,6 +33,8 @@ void Enemy::Init(const EngineContext& engineContext)
     collider->SetUseTransformScale(true);
     SetCollider(std::move(collider));
     SetCollision(engineContext.stateManager->GetCurrentState()->GetObjectManager(), "enemy", { "player" });
+
+    bulletPool = engineContext.stateManager->GetCurrentState()->GetObjectManager().CreatePool<Bullet>(engineContext, "enemyBullet", 64, glm::vec2(0.f), glm::vec2(1.f, 0.f));
 }
 
 void Enemy::LateInit(const EngineContext& engineContext)
@@ -66,26 +68,26 @@ void Enemy::Update(float dt, const EngineContext& engineContext)
 
     if (engineContext.inputManager->IsKeyPressed(KEY_UP))
     {
-        spriteAnimator->PlayClip("backwalk");
+        spriteAnimator->PlayClip("backwalk"_sid);
     }
     if (engineContext.inputManager->IsKeyPressed(KEY_LEFT))
     {
         SetFlipUV_X(true);
-        spriteAnimator->PlayClip("sidewalk");
+        spriteAnimator->PlayClip("sidewalk"_sid);
     }
     if (engineContext.inputManager->IsKeyPressed(KEY_DOWN))
     {
-        spriteAnimator->PlayClip("frontwalk");
+        spriteAnimator->PlayClip("frontwalk"_sid);
     }
     if (engineContext.inputManager->IsKeyPressed(KEY_RIGHT))
     {
         SetFlipUV_X(false);
-        spriteAnimator->PlayClip("sidewalk");
+        spriteAnimator->PlayClip("sidewalk"_sid);
     }
 
     if (checkIdle)
     {
-        spriteAnimator->PlayClip("idle");
+        spriteAnimator->PlayClip("idle"_sid);
     }
 
     if (engineContext.inputManager->IsKeyDown(KEY_RIGHT_CONTROL))
@@ -99,8 +101,7 @@ void Enemy::Update(float dt, const EngineContext& engineContext)
         for (int i = 0; i < 10; i++)
         {
             float angle = angleDist(gen);
-            std::unique_ptr<Bullet> b = std::make_unique<Bullet>(transform2D.GetPosition(), glm::vec2(std::cos(angle), std::sin(angle)));
-            engineContext.stateManager->GetCurrentState()->GetObjectManager().AddObject(std::move(b), "enemyBullet");
+            bulletPool->Acquire()->Launch(transform2D.GetPosition(), glm::vec2(std::cos(angle), std::sin(angle)));
         }
     }
 }
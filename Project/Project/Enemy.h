@@ -2,6 +2,8 @@
 #include "ObjectManager.h"
 #include "Engine.h"
 
+class Bullet;
+
 class Enemy : public GameObject
 {
 public:
@@ -16,5 +18,6 @@ public:
     bool CheckIdle();
 private:
     bool checkIdle = true;
+    ObjectPool<Bullet>* bulletPool = nullptr;
 };
 
@@ -37,6 +37,9 @@ void Level1::Init(const EngineContext& engineContext)
 
     SNAKE_LOG("[Level1] init called");
 
+    //the apples are static colliders, what is left is the selection box, which can span the whole board
+    objectManager.SetBroadPhase(BroadPhaseType::DynamicAABBTree);
+
     auto font = engineContext.renderManager->GetFontByTag("default");
 
     cameraManager.GetActiveCamera()->SetPosition(
@@ -83,25 +86,47 @@ void Level1::Init(const EngineContext& engineContext)
 
     objectManager.AddObject(std::make_unique<ApplePlayerController>(), "player_controller");
 
-    for (int row = 0; row < rows; ++row)
-    {
-        for (int col = 0; col < cols; ++col)
+    const size_t appleCount = static_cast<size_t>(rows) * cols;
+    std::vector<int> values(appleCount);
+    for (int& value : values)
+        value = dist(gen);
+
+    auto cellPosition = [this](size_t index)
         {
-            glm::vec2 pos = { col * (spacingX + appleSizeX) * multiplier, row * (spacingY + appleSizeY) * multiplier };
-            int value = dist(gen);
-
-            auto text = new TextObject(engineContext.renderManager->GetFontByTag("default"), std::to_string(value), TextAlignH::Center, TextAlignV::Middle);
-            objectManager.AddObject(std::unique_ptr<TextObject>(text), "apple_text");
-            text->GetTransform2D().SetPosition(pos);
-            text->GetTransform2D().SetScale({ 0.5,0.5 });
-            text->SetRenderLayer("UI");
-
-            Apple* apple = (Apple*)objectManager.AddObject(std::make_unique<Apple>(text, value), "apple");
-            apple->GetTransform2D().SetPosition({pos});
-            apple->GetTransform2D().SetScale({ appleSizeX, appleSizeY });
-            apple->SetRenderLayer("Game");
-        }
-    }
+            const int row = static_cast<int>(index) / cols;
+            const int col = static_cast<int>(index) % cols;
+            return glm::vec2{ col * (spacingX + appleSizeX) * multiplier, row * (spacingY + appleSizeY) * multiplier };
+        };
+
+    Prefab labelPrefab;
+    labelPrefab.tag = "apple_text";
+    labelPrefab.renderLayer = "UI";
+    labelPrefab.scale = glm::vec2(0.5f);
+    labelPrefab.updatePolicy = UpdatePolicy::Interval;
+    labelPrefab.updateInterval = 8;
+
+    std::vector<TextObject*> labels = objectManager.InstantiateBatch<TextObject>(engineContext, labelPrefab, appleCount,
+        [&](size_t i) { return std::make_tuple(font, std::to_string(values[i]), TextAlignH::Center, TextAlignV::Middle); },
+        [&](TextObject& text, size_t i) { text.GetTransform2D().SetPosition(cellPosition(i)); });
+
+    Prefab applePrefab;
+    applePrefab.tag = "apple";
+    applePrefab.meshTag = "default";
+    applePrefab.materialTag = "m_apple";
+    applePrefab.renderLayer = "Game";
+    applePrefab.scale = glm::vec2(appleSizeX, appleSizeY);
+    applePrefab.colliderFactory = [](Object* owner)
+        {
+            auto collider = std::make_unique<AABBCollider>(owner, glm::vec2(0.9f, 0.9f));
+            collider->SetStatic(true);
+            return collider;
+        };
+    applePrefab.collisionGroup = "apple";
+    applePrefab.collidesWith = { "player_selection" };
+
+    objectManager.InstantiateBatch<Apple>(engineContext, applePrefab, appleCount,
+        [&](size_t i) { return std::make_tuple(labels[i]->GetHandle(), values[i]); },
+        [&](Apple& apple, size_t i) { apple.GetTransform2D().SetPosition(cellPosition(i)); });
 
     fillInitialScaleY = engineContext.windowManager->GetHeight() * 0.8f;
     glm::vec2 pos = { cols * (spacingX + appleSizeX) * multiplier, fillInitialScaleY * 0.5f };
@@ -135,12 +160,12 @@ void Level1::Update(float dt, const EngineContext& engineContext)
     HandleStateInput(engineContext);
     if (gameTimer.IsTimedOut())
     {
-        ApplePlayerController* player = (ApplePlayerController*)objectManager.FindByTag("player_controller");
+        ApplePlayerController* player = (ApplePlayerController*)objectManager.FindByTag("player_controller"_sid);
         player->SetVisibility(false);
         scoreUIText->SetText(std::to_string(player->GetScore()));
         scoreUIText->SetVisibility(true);
         restartUIText->SetVisibility(true);
-        Object* scoreUIObj = objectManager.FindByTag("score_ui");
+        Object* scoreUIObj = objectManager.FindByTag("score_ui"_sid);
 
 
     	float pulse = std::sin(dokidoki.GetElapsed() * 6.0f) * 10.f + 400.0f;
@@ -149,7 +174,7 @@ void Level1::Update(float dt, const EngineContext& engineContext)
     	scoreUIObj->SetVisibility(true);
 
         std::vector<Object*> selected_objects;
-        objectManager.FindByTag("apple", selected_objects);
+        objectManager.FindByTag("apple"_sid, selected_objects);
 
         
     	for (Object* obj : selected_objects)
@@ -13,6 +13,8 @@ void MainMenu::Init(const EngineContext& engineContext)
 {
     SNAKE_LOG("[MainMenu] init called");
 
+    objectManager.SetParallelUpdate(true);
+
     objectManager.AddObject(std::make_unique<Player>(), "player")->SetRenderLayer("Penguin");
     objectManager.AddObject(std::make_unique<Enemy>(glm::vec2(200,0)), "enemy");
 
@@ -103,6 +105,16 @@ void MainMenu::Update(float dt, const EngineContext& engineContext)
     {
         engineContext.engine->RenderDebugDraws(false);
     }
+    if (engineContext.inputManager->IsKeyPressed(KEY_T))
+    {
+        engineContext.engine->GetFrameTaskGraph().LogTimings();
+    }
+    if (engineContext.inputManager->IsKeyPressed(KEY_B))
+    {
+        BroadPhaseBenchmarkSettings settings;
+        settings.colliderSizes = BroadPhaseBenchmark::SampleColliderSizes(objectManager);
+        BroadPhaseBenchmark::LogResults(BroadPhaseBenchmark::Run(settings));
+    }
 
     if (startButton->GetColor() == glm::vec4(0.3, 0.3, 0.3, 1.0))
     {
@@ -148,22 +160,19 @@ void MainMenu::Update(float dt, const EngineContext& engineContext)
         quitText->SetColor({ 1.0,1.0,1.0,1.0 });
     }
 
-    std::vector<Object*> bullets;
-    objectManager.FindByTag("bullet", bullets);
-    for (auto* bullet : bullets)
+    Object* player = objectManager.FindByTag("player"_sid);
+    ObjectQuery bullets = objectManager.Query("bullet"_sid);
+    for (Object* bullet : bullets)
     {
         engineContext.renderManager->DrawDebugLine(
             bullet->GetTransform2D().GetPosition(),
-            objectManager.FindByTag("player")->GetWorldPosition(),
+            player->GetWorldPosition(),
             cameraManager.GetActiveCamera());
     }
 
-    objectManager.FindByTag("enemyBullet", bullets);
-    auto cnt = bullets.size();
-    objectManager.FindByTag("111", bullets);
-    cnt += bullets.size();
+    size_t cnt = bullets.Count() + objectManager.Query("enemyBullet"_sid).Count() + objectManager.Query("111"_sid).Count();
     bulletCountText->SetText(std::to_string(cnt));
-    bulletCountText->GetTransform2D().SetPosition(objectManager.FindByTag("player")->GetTransform2D().GetPosition() + glm::vec2(0, 50));
+    bulletCountText->GetTransform2D().SetPosition(player->GetTransform2D().GetPosition() + glm::vec2(0, 50));
 
     auto cam = cameraManager.GetActiveCamera();
     auto& input = *engineContext.inputManager;
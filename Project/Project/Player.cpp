@@ -20,12 +20,16 @@ void Player::Init(const EngineContext& engineContext)
     sheet->AddClip("backwalk", { 80,81,82,83,84,85 }, 0.08f, true);
     sheet->AddClip("idle", { 9 }, 0.08f, false);
     AttachAnimator(sheet, 0.08f);
-    spriteAnimator->PlayClip("idle");
+    spriteAnimator->PlayClip("idle"_sid);
 
     auto collider = std::make_unique<AABBCollider>(this, glm::vec2(1.0, 1.0));
     collider->SetUseTransformScale(true);
     SetCollider(std::move(collider));
     SetCollision(engineContext.stateManager->GetCurrentState()->GetObjectManager(), "player", { "bullet","enemy", "button" });
+
+    ObjectManager& objectManager = engineContext.stateManager->GetCurrentState()->GetObjectManager();
+    bulletPool = objectManager.CreatePool<Bullet>(engineContext, "bullet", 16, glm::vec2(0.f), glm::vec2(1.f, 0.f));
+    bullet1Pool = objectManager.CreatePool<Bullet1>(engineContext, "111", 64, glm::vec2(0.f), glm::vec2(1.f, 0.f));
 }
 
 void Player::LateInit(const EngineContext& engineContext)
@@ -59,26 +63,26 @@ void Player::Update(float dt, const EngineContext& engineContext)
 
     if (spriteAnimator && engineContext.inputManager->IsKeyPressed(KEY_W))
     {
-        spriteAnimator->PlayClip("backwalk");
+        spriteAnimator->PlayClip("backwalk"_sid);
     }
     if (spriteAnimator && engineContext.inputManager->IsKeyPressed(KEY_A))
     {
         SetFlipUV_X(true);
-        spriteAnimator->PlayClip("sidewalk");
+        spriteAnimator->PlayClip("sidewalk"_sid);
     }
     if (spriteAnimator && engineContext.inputManager->IsKeyPressed(KEY_S))
     {
-        spriteAnimator->PlayClip("frontwalk");
+        spriteAnimator->PlayClip("frontwalk"_sid);
     }
     if (spriteAnimator && engineContext.inputManager->IsKeyPressed(KEY_D))
     {
         SetFlipUV_X(false);
-        spriteAnimator->PlayClip("sidewalk");
+        spriteAnimator->PlayClip("sidewalk"_sid);
     }
 
     if (spriteAnimator&&checkIdle)
     {
-        spriteAnimator->PlayClip("idle");
+        spriteAnimator->PlayClip("idle"_sid);
     }
     if (engineContext.inputManager->IsKeyPressed(KEY_SPACE))
     {
@@ -89,8 +93,7 @@ void Player::Update(float dt, const EngineContext& engineContext)
         static std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * glm::pi<float>());
 
         float angle = angleDist(gen);
-        std::unique_ptr<Bullet> b = std::make_unique<Bullet>(GetWorldPosition(), glm::vec2(std::cos(angle), std::sin(angle)));
-        engineContext.stateManager->GetCurrentState()->GetObjectManager().AddObject(std::move(b), "bullet");
+        bulletPool->Acquire()->Launch(GetWorldPosition(), glm::vec2(std::cos(angle), std::sin(angle)));
     }
 
 
@@ -105,8 +108,7 @@ void Player::Update(float dt, const EngineContext& engineContext)
         for (int i = 0; i < 10; i++)
         {
             float angle = angleDist(gen);
-            std::unique_ptr<Bullet1> b = std::make_unique<Bullet1>(transform2D.GetPosition(), glm::vec2(std::cos(angle), std::sin(angle)));
-            engineContext.stateManager->GetCurrentState()->GetObjectManager().AddObject(std::move(b), "111");
+            bullet1Pool->Acquire()->Launch(transform2D.GetPosition(), glm::vec2(std::cos(angle), std::sin(angle)));
         }
     }
 }
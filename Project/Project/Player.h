@@ -2,6 +2,9 @@
 #include "ObjectManager.h"
 #include "Engine.h"
 
+class Bullet;
+class Bullet1;
+
 class Player : public GameObject
 {
 public:
@@ -15,5 +18,7 @@ public:
     bool CheckIdle();
 private:
     bool checkIdle = true;
+    ObjectPool<Bullet>* bulletPool = nullptr;
+    ObjectPool<Bullet1>* bullet1Pool = nullptr;
 };
 
@@ -41,10 +41,15 @@ void SpriteSheet::AddClip(const std::string& name, const std::vector<int>& frame
     clip.frameDuration = frameDuration;
     clip.looping = looping;
 
-    animationClips[name] = clip;
+    animationClips[StringID::Intern(name)] = clip;
 }
 
 const SpriteClip* SpriteSheet::GetClip(const std::string& name) const
+{
+    return GetClip(StringID(name));
+}
+
+const SpriteClip* SpriteSheet::GetClip(StringID name) const
 {
     auto it = animationClips.find(name);
     if (it != animationClips.end())
@@ -69,6 +74,11 @@ void SpriteAnimator::PlayClip(int start, int end, bool loop_)
     elapsed = 0.0f;
 }
 void SpriteAnimator::PlayClip(const std::string& clipName)
+{
+    PlayClip(StringID(clipName));
+}
+
+void SpriteAnimator::PlayClip(StringID clipName)
 {
     if (!sheet)
     {
@@ -78,7 +88,7 @@ void SpriteAnimator::PlayClip(const std::string& clipName)
     const auto* clip = sheet->GetClip(clipName);
     if (!clip || clip->frameIndices.empty())
     {
-        SNAKE_WRN("Can't play clip: There is no clip named \"" <<clipName<< "\".");
+        SNAKE_WRN("Can't play clip: There is no clip named \"" << clipName.GetString() << "\".");
         return;
     }
     playingClip = clip;
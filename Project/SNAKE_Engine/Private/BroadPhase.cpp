@@ -0,0 +1,66 @@
+#include "Engine.h"
+
+#include <bit>
+#include <cmath>
+
+std::unique_ptr<BroadPhase> CreateBroadPhase(BroadPhaseType type)
+{
+    switch (type)
+    {
+    case BroadPhaseType::DynamicAABBTree:
+        return std::make_unique<DynamicAABBTree>();
+    case BroadPhaseType::SweepAndPrune:
+        return std::make_unique<SweepAndPrune>();
+    case BroadPhaseType::HierarchicalGrid:
+        return std::make_unique<HierarchicalGrid>();
+    case BroadPhaseType::SpatialHashGrid:
+    default:
+        return std::make_unique<SpatialHashGrid>();
+    }
+}
+
+const char* GetBroadPhaseName(BroadPhaseType type)
+{
+    switch (type)
+    {
+    case BroadPhaseType::DynamicAABBTree:
+        return "DynamicAABBTree";
+    case BroadPhaseType::SweepAndPrune:
+        return "SweepAndPrune";
+    case BroadPhaseType::HierarchicalGrid:
+        return "HierarchicalGrid";
+    case BroadPhaseType::SpatialHashGrid:
+    default:
+        return "SpatialHashGrid";
+    }
+}
+
+void BoundsSizeHistogram::Clear()
+{
+    counts.fill(0);
+    total = 0;
+}
+
+void BoundsSizeHistogram::Add(const glm::vec2& boundsMin, const glm::vec2& boundsMax)
+{
+    const glm::vec2 size = boundsMax - boundsMin;
+    const float largest = std::ceil(std::max(size.x, size.y));
+    const uint32_t rounded = largest > 1.f ? static_cast<uint32_t>(std::min(largest, 1073741824.f)) : 1u;
+    //bucket b holds sizes in (2^(b-1), 2^b]
+    const int bucket = std::min(static_cast<int>(std::bit_width(rounded - 1u)), BUCKET_COUNT - 1);
+    ++counts[bucket];
+    ++total;
+}
+
+int BoundsSizeHistogram::GetPercentile(float fraction) const
+{
+    const uint32_t target = std::max(1u, static_cast<uint32_t>(std::ceil(fraction * static_cast<float>(total))));
+    uint32_t seen = 0;
+    for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket)
+    {
+        seen += counts[bucket];
+        if (seen >= target)
+            return 1 << bucket;
+    }
+    return 1 << (BUCKET_COUNT - 1);
+}
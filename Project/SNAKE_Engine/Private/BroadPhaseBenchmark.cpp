@@ -0,0 +1,119 @@
+#include "Engine.h"
+
+#include <chrono>
+#include <iomanip>
+#include <random>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<glm::vec2> GetDefaultColliderSizes()
+    {
+        std::vector<glm::vec2> sizes;
+        for (int i = 0; i < 16; ++i)
+            sizes.push_back(glm::vec2(8.f + i));
+        for (int i = 0; i < 4; ++i)
+            sizes.push_back(glm::vec2(40.f + 20.f * i, 60.f + 20.f * i));
+        sizes.push_back({ 1600.f, 900.f });
+        return sizes;
+    }
+}
+
+std::vector<BroadPhaseBenchmarkResult> BroadPhaseBenchmark::Run(const BroadPhaseBenchmarkSettings& settings)
+{
+    const std::vector<glm::vec2> sizes = settings.colliderSizes.empty() ? GetDefaultColliderSizes() : settings.colliderSizes;
+
+    //only the addresses are used, the objects are never initialized
+    std::vector<std::unique_ptr<GameObject>> objects;
+    objects.reserve(settings.objectCount);
+    for (size_t i = 0; i < settings.objectCount; ++i)
+        objects.push_back(std::make_unique<GameObject>());
+
+    std::vector<glm::vec2> positions(settings.objectCount);
+    std::vector<glm::vec2> velocities(settings.objectCount);
+    std::vector<glm::vec2> halfSizes(settings.objectCount);
+    std::vector<BroadPhasePair> pairs;
+
+    std::vector<BroadPhaseBenchmarkResult> results;
+    for (BroadPhaseType type : { BroadPhaseType::SpatialHashGrid, BroadPhaseType::HierarchicalGrid, BroadPhaseType::DynamicAABBTree, BroadPhaseType::SweepAndPrune })
+    {
+        std::mt19937 gen(settings.seed);
+        std::uniform_real_distribution<float> unit(0.f, 1.f);
+        std::uniform_int_distribution<size_t> sizeIndex(0, sizes.size() - 1);
+        for (size_t i = 0; i < settings.objectCount; ++i)
+        {
+            positions[i] = glm::vec2(unit(gen), unit(gen)) * settings.worldSize;
+            halfSizes[i] = sizes[sizeIndex(gen)] * 0.5f;
+            const bool isMoving = unit(gen) < settings.movingRatio;
+            velocities[i] = isMoving ? (glm::vec2(unit(gen), unit(gen)) * 2.f - 1.f) * settings.maxSpeed : glm::vec2(0.f);
+        }
+
+        std::unique_ptr<BroadPhase> broadPhase = CreateBroadPhase(type);
+        BroadPhaseBenchmarkResult result{ type };
+        for (int frame = 0; frame < settings.frameCount; ++frame)
+        {
+            for (size_t i = 0; i < settings.objectCount; ++i)
+            {
+                positions[i] += velocities[i] * settings.dt;
+                for (int axis = 0; axis < 2; ++axis)
+                {
+                    if (positions[i][axis] < 0.f || positions[i][axis] > settings.worldSize[axis])
+                        velocities[i][axis] = -velocities[i][axis];
+                }
+            }
+
+            pairs.clear();
+            const Clock::time_point start = Clock::now();
+            broadPhase->BeginFrame();
+            for (size_t i = 0; i < settings.objectCount; ++i)
+                broadPhase->Insert(objects[i].get(), positions[i] - halfSizes[i], positions[i] + halfSizes[i]);
+            broadPhase->ComputePairs(pairs);
+            const float milliseconds = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+            result.averageMilliseconds += milliseconds;
+            result.worstMilliseconds = std::max(result.worstMilliseconds, milliseconds);
+            result.totalPairs += pairs.size();
+        }
+
+        if (settings.frameCount > 0)
+            result.averageMilliseconds /= static_cast<float>(settings.frameCount);
+        results.push_back(result);
+    }
+
+    for (const BroadPhaseBenchmarkResult& result : results)
+    {
+        if (result.totalPairs != results.front().totalPairs)
+            SNAKE_WRN("[BroadPhaseBenchmark] " << GetBroadPhaseName(result.type) << " found " << result.totalPairs
+                << " pairs, " << GetBroadPhaseName(results.front().type) << " found " << results.front().totalPairs);
+    }
+    return results;
+}
+
+std::vector<glm::vec2> BroadPhaseBenchmark::SampleColliderSizes(const ObjectManager& objectManager)
+{
+    const ObjectComponentStore& store = objectManager.GetComponentStore();
+    const std::vector<ComponentBounds>& bounds = store.GetColliderBounds();
+
+    std::vector<glm::vec2> sizes;
+    for (uint32_t row = 0; row < store.GetSize(); ++row)
+    {
+        const Object* owner = store.GetOwner(row);
+        if (owner->IsAlive() && owner->GetCollider())
+            sizes.push_back(bounds[row].max - bounds[row].min);
+    }
+    return sizes;
+}
+
+void BroadPhaseBenchmark::LogResults(const std::vector<BroadPhaseBenchmarkResult>& results)
+{
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(3) << "[BroadPhaseBenchmark]";
+    for (const BroadPhaseBenchmarkResult& result : results)
+    {
+        report << "\n  " << std::left << std::setw(16) << GetBroadPhaseName(result.type)
+            << " avg " << result.averageMilliseconds << " ms, worst " << result.worstMilliseconds
+            << " ms, " << result.totalPairs << " pairs";
+    }
+    SNAKE_LOG(report.str());
+}
@@ -1,13 +1,29 @@
 #include "Engine.h"
 
-#define GLM_ENABLE_EXPERIMENTAL
+#include <algorithm>
 #include <unordered_set>
 
-#include "gtx/norm.hpp"
+void Collider::SetUseTransformScale(bool use)
+{
+    if (useTransformScale == use)
+        return;
+    useTransformScale = use;
+    RefreshShape();
+}
 
-float CircleCollider::GetRadius() const
+void Collider::RefreshShape()
 {
-    return useTransformScale ? baseRadius * std::max(glm::abs(owner->GetWorldScale().x), glm::abs(owner->GetWorldScale().y)): scaledRadius;
+    SyncWithTransformScale();
+    if (owner->GetCollider() == this)
+        owner->SyncColliderRow();
+}
+
+void Collider::SetStatic(bool isStatic_)
+{
+    if (isStatic == isStatic_)
+        return;
+    isStatic = isStatic_;
+    owner->SyncColliderRow();
 }
 
 float CircleCollider::GetSize() const
@@ -18,9 +34,7 @@ float CircleCollider::GetSize() const
 void CircleCollider::SetRadius(float r)
 {
     baseRadius = r;
-
-    if (!useTransformScale)
-        scaledRadius = r;
+    RefreshShape();
 }
 
 float CircleCollider::GetBoundingRadius() const
@@ -28,32 +42,16 @@ float CircleCollider::GetBoundingRadius() const
     return GetRadius();
 }
 
-bool CircleCollider::CheckCollision(const Collider* other) const
-{
-    return other->DispatchAgainst(*this);
-}
-
-bool CircleCollider::DispatchAgainst(const CircleCollider& other) const
-{
-    glm::vec2 a = owner->GetWorldPosition();
-    glm::vec2 b = other.GetOwner()->GetWorldPosition();
-
-    float distSqr = glm::length2(a - b);
-    float rSum = GetRadius() + other.GetRadius();
-    return distSqr <= rSum * rSum;
-}
-
-bool CircleCollider::DispatchAgainst(const AABBCollider& other) const
-{
-    return other.DispatchAgainst(*this);
-}
-
 void CircleCollider::SyncWithTransformScale()
 {
-    if (!useTransformScale) return;
+    if (!useTransformScale)
+    {
+        scaledRadius = baseRadius;
+        return;
+    }
 
-    float scale = std::max(glm::abs(owner->GetWorldScale().x),glm::abs(owner->GetWorldScale().y));
-    scaledRadius = baseRadius * scale;
+    const glm::vec2 scale = glm::abs(owner->GetWorldScale());
+    scaledRadius = baseRadius * std::max(scale.x, scale.y);
 }
 
 bool CircleCollider::CheckPointCollision(const glm::vec2& point) const
@@ -83,11 +81,6 @@ void CircleCollider::DrawDebug(RenderManager* rm, Camera2D* cam, const glm::vec4
 }
 
 
-glm::vec2 AABBCollider::GetHalfSize() const
-{
-    return useTransformScale ? baseHalfSize * glm::abs(owner->GetWorldScale()) : scaledHalfSize;
-}
-
 glm::vec2 AABBCollider::GetSize() const
 {
     return GetHalfSize() * glm::vec2(2);
@@ -95,10 +88,8 @@ glm::vec2 AABBCollider::GetSize() const
 
 void AABBCollider::SetSize(const glm::vec2& size)
 {
-    baseHalfSize = size/glm::vec2(2);
-
-    if (!useTransformScale)
-        scaledHalfSize = size / glm::vec2(2);
+    baseHalfSize = size / glm::vec2(2);
+    RefreshShape();
 }
 
 float AABBCollider::GetBoundingRadius() const
@@ -108,11 +99,6 @@ float AABBCollider::GetBoundingRadius() const
 }
 
 
-bool AABBCollider::CheckCollision(const Collider* other) const
-{
-    return other->DispatchAgainst(*this);
-}
-
 bool AABBCollider::CheckPointCollision(const glm::vec2& point) const
 {
     glm::vec2 center = owner->GetWorldPosition();
@@ -125,22 +111,9 @@ bool AABBCollider::CheckPointCollision(const glm::vec2& point) const
         point.y >= min.y && point.y <= max.y;
 }
 
-bool AABBCollider::DispatchAgainst(const AABBCollider& other) const
-{
-    glm::vec2 aPos = owner->GetWorldPosition();
-    glm::vec2 bPos = other.GetOwner()->GetWorldPosition();
-
-    glm::vec2 aHalf = GetHalfSize();
-    glm::vec2 bHalf = other.GetHalfSize();
-
-    return std::abs(aPos.x - bPos.x) <= (aHalf.x + bHalf.x) &&
-        std::abs(aPos.y - bPos.y) <= (aHalf.y + bHalf.y);
-}
-
 void AABBCollider::SyncWithTransformScale()
 {
-    if (useTransformScale)
-        scaledHalfSize = baseHalfSize * glm::abs(owner->GetWorldScale());
+    scaledHalfSize = useTransformScale ? baseHalfSize * glm::abs(owner->GetWorldScale()) : baseHalfSize;
 }
 
 void AABBCollider::DrawDebug(RenderManager* rm, Camera2D* cam, const glm::vec4& color) const
@@ -157,61 +130,189 @@ void AABBCollider::DrawDebug(RenderManager* rm, Camera2D* cam, const glm::vec4&
     rm->DrawDebugLine({ min.x, max.y }, { min.x, min.y }, cam, color);
 }
 
-bool AABBCollider::DispatchAgainst(const CircleCollider& other) const
+void SpatialHashGrid::Clear()
 {
-    glm::vec2 aPos = owner->GetWorldPosition();
-    glm::vec2 half = GetHalfSize();
+    entries.clear();
+    coverCount = 0;
+    isBuilt = false;
+}
 
-    glm::vec2 circlePos = other.GetOwner()->GetWorldPosition();
-    float radius = other.GetRadius();
+void SpatialHashGrid::Reset()
+{
+    Clear();
+    usedCells.clear();
+    entryCells.clear();
+    cellEntries.clear();
+    //table slots are only trusted when their stamp matches, so the table itself can stay
+}
 
-    glm::vec2 closest = glm::clamp(circlePos, aPos - half, aPos + half);
-    float distSqr = glm::length2(circlePos - closest);
+void SpatialHashGrid::Insert(Object* obj, const glm::vec2& boundsMin, const glm::vec2& boundsMax)
+{
+    glm::ivec2 minCell = GetCell(boundsMin);
+    glm::ivec2 maxCell = GetCell(boundsMax);
+
+    entriesMin = entries.empty() ? boundsMin : glm::min(entriesMin, boundsMin);
+    entriesMax = entries.empty() ? boundsMax : glm::max(entriesMax, boundsMax);
+    entries.push_back({ obj, boundsMin, boundsMax, minCell, maxCell });
+    coverCount += static_cast<size_t>(maxCell.x - minCell.x + 1) * static_cast<size_t>(maxCell.y - minCell.y + 1);
+    isBuilt = false;
+}
 
-    return distSqr <= radius * radius;
+void SpatialHashGrid::SetCellSize(int size)
+{
+    autoTuneCellSize = false;
+    size = std::max(size, 1);
+    if (size == cellSize)
+        return;
+    cellSize = size;
+    AssignCells();
 }
 
+void SpatialHashGrid::TuneCellSize()
+{
+    if (entries.empty())
+        return;
 
+    sizeHistogram.Clear();
+    for (const Entry& entry : entries)
+        sizeHistogram.Add(entry.boundsMin, entry.boundsMax);
 
-void SpatialHashGrid::Clear()
+    //grow as soon as the colliders outgrow the cells, but only shrink once they are well below them,
+    //so a scene sitting on a boundary does not flip every frame
+    const int ideal = std::clamp(sizeHistogram.GetPercentile(0.9f), MIN_CELL_SIZE, MAX_CELL_SIZE);
+    if (ideal > cellSize || ideal * 4 <= cellSize)
+    {
+        cellSize = ideal;
+        AssignCells();
+    }
+}
+
+void SpatialHashGrid::AssignCells()
 {
-    grid.clear();
+    coverCount = 0;
+    for (Entry& entry : entries)
+    {
+        entry.minCell = GetCell(entry.boundsMin);
+        entry.maxCell = GetCell(entry.boundsMax);
+        coverCount += static_cast<size_t>(entry.maxCell.x - entry.minCell.x + 1) * static_cast<size_t>(entry.maxCell.y - entry.minCell.y + 1);
+    }
+    isBuilt = false;
 }
 
-void SpatialHashGrid::Insert(Object* obj)
+void SpatialHashGrid::Build()
 {
-    if (!obj->IsAlive() || !obj->GetCollider())
+    if (isBuilt)
         return;
+    if (autoTuneCellSize)
+        TuneCellSize();
+    isBuilt = true;
+
+    //at most half full, so probe chains stay short
+    size_t capacity = 16;
+    while (capacity < coverCount * 2)
+        capacity <<= 1;
+    if (table.size() < capacity)
+        table.assign(capacity, Cell{});
+
+    if (++stamp == 0)
+    {
+        for (Cell& cell : table)
+            cell.stamp = 0;
+        stamp = 1;
+    }
 
-    glm::vec2 pos = obj->GetWorldPosition();
-    float radius = obj->GetCollider()->GetBoundingRadius();
+    usedCells.clear();
+    entryCells.clear();
+    entryCells.reserve(coverCount);
 
-    glm::ivec2 minCell = GetCell(pos - glm::vec2(radius));
-    glm::ivec2 maxCell = GetCell(pos + glm::vec2(radius));
+    for (const Entry& entry : entries)
+    {
+        for (int y = entry.minCell.y; y <= entry.maxCell.y; ++y)
+        {
+            for (int x = entry.minCell.x; x <= entry.maxCell.x; ++x)
+            {
+                uint32_t slot = FindOrAddCell({ x, y });
+                ++table[slot].count;
+                entryCells.push_back(slot);
+            }
+        }
+    }
 
-    for (int y = minCell.y; y <= maxCell.y; ++y)
+    uint32_t offset = 0;
+    for (uint32_t slot : usedCells)
     {
-        for (int x = minCell.x; x <= maxCell.x; ++x)
+        Cell& cell = table[slot];
+        cell.start = offset;
+        offset += cell.count;
+        //reused as the scatter cursor and counts back up to the cell size
+        cell.count = 0;
+    }
+
+    cellEntries.resize(offset);
+    size_t cover = 0;
+    for (uint32_t entryIndex = 0; entryIndex < entries.size(); ++entryIndex)
+    {
+        const Entry& entry = entries[entryIndex];
+        const size_t cellsCovered = static_cast<size_t>(entry.maxCell.x - entry.minCell.x + 1) * static_cast<size_t>(entry.maxCell.y - entry.minCell.y + 1);
+        for (size_t i = 0; i < cellsCovered; ++i)
         {
-            InsertToCell(obj, { x, y });
+            Cell& cell = table[entryCells[cover++]];
+            cellEntries[cell.start + cell.count++] = entryIndex;
         }
     }
 }
-void SpatialHashGrid::ComputeCollisions(std::function<void(Object*, Object*)> onCollision)
+
+uint32_t SpatialHashGrid::FindOrAddCell(const glm::ivec2& coord)
 {
-    for (auto& [cell, list] : grid)
+    const uint32_t mask = static_cast<uint32_t>(table.size() - 1);
+    uint32_t slot = static_cast<uint32_t>(HashCell(coord)) & mask;
+    while (true)
     {
-        const size_t count = list.size();
-        for (size_t i = 0; i < count; ++i)
+        Cell& cell = table[slot];
+        if (cell.stamp != stamp)
         {
-            for (size_t j = i + 1; j < count; ++j)
-            {
-                onCollision(list[i], list[j]);
-            }
+            cell.coord = coord;
+            cell.count = 0;
+            cell.stamp = stamp;
+            usedCells.push_back(slot);
+            return slot;
         }
+        if (cell.coord == coord)
+            return slot;
+        slot = (slot + 1) & mask;
+    }
+}
+
+const SpatialHashGrid::Cell* SpatialHashGrid::FindCell(const glm::ivec2& coord) const
+{
+    if (table.empty())
+        return nullptr;
+
+    const uint32_t mask = static_cast<uint32_t>(table.size() - 1);
+    uint32_t slot = static_cast<uint32_t>(HashCell(coord)) & mask;
+    while (true)
+    {
+        const Cell& cell = table[slot];
+        if (cell.stamp != stamp)
+            return nullptr;
+        if (cell.coord == coord)
+            return &cell;
+        slot = (slot + 1) & mask;
     }
 }
 
+uint64_t SpatialHashGrid::HashCell(const glm::ivec2& coord)
+{
+    //pack both signed coordinates losslessly, then mix so neighbouring and negative cells spread over the table
+    uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(coord.x)) << 32) | static_cast<uint32_t>(coord.y);
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    return key;
+}
+
+
+
 glm::ivec2 SpatialHashGrid::GetCell(const glm::vec2& pos) const
 {
     return glm::ivec2(
@@ -220,11 +321,6 @@ glm::ivec2 SpatialHashGrid::GetCell(const glm::vec2& pos) const
     );
 }
 
-void SpatialHashGrid::InsertToCell(Object* obj, const glm::ivec2& cell)
-{
-    grid[cell].push_back(obj);
-}
-
 uint32_t CollisionGroupRegistry::GetGroupBit(const std::string& tag)
 {
     auto it = tagToBit.find(tag);
@@ -0,0 +1,325 @@
+#include "Engine.h"
+
+#include <algorithm>
+
+namespace
+{
+    float Perimeter(const glm::vec2& min, const glm::vec2& max)
+    {
+        return 2.f * ((max.x - min.x) + (max.y - min.y));
+    }
+
+    bool Overlaps(const glm::vec2& aMin, const glm::vec2& aMax, const glm::vec2& bMin, const glm::vec2& bMax)
+    {
+        return aMin.x <= bMax.x && bMin.x <= aMax.x && aMin.y <= bMax.y && bMin.y <= aMax.y;
+    }
+}
+
+void DynamicAABBTree::Insert(Object* obj, const glm::vec2& boundsMin, const glm::vec2& boundsMax)
+{
+    auto [it, inserted] = leafOf.try_emplace(obj, NULL_NODE);
+    if (inserted)
+    {
+        const int leaf = AllocateNode();
+        it->second = leaf;
+
+        Node& node = nodes[leaf];
+        node.object = obj;
+        node.boundsMin = boundsMin;
+        node.boundsMax = boundsMax;
+        node.height = 0;
+        node.lastSeenFrame = frame;
+        node.leafSlot = static_cast<uint32_t>(leaves.size());
+        leaves.push_back(leaf);
+
+        Fatten(node);
+        InsertLeaf(leaf);
+        return;
+    }
+
+    const int leaf = it->second;
+    Node& node = nodes[leaf];
+    node.boundsMin = boundsMin;
+    node.boundsMax = boundsMax;
+    node.lastSeenFrame = frame;
+
+    if (glm::all(glm::greaterThanEqual(boundsMin, node.fatMin)) && glm::all(glm::lessThanEqual(boundsMax, node.fatMax)))
+        return;
+
+    RemoveLeaf(leaf);
+    Fatten(nodes[leaf]);
+    InsertLeaf(leaf);
+}
+
+void DynamicAABBTree::Build()
+{
+    for (size_t i = 0; i < leaves.size();)
+    {
+        if (nodes[leaves[i]].lastSeenFrame != frame)
+            RemoveProxy(leaves[i]);
+        else
+            ++i;
+    }
+}
+
+void DynamicAABBTree::ComputePairs(std::vector<BroadPhasePair>& outPairs)
+{
+    Build();
+
+    for (int leaf : leaves)
+    {
+        const Node& query = nodes[leaf];
+
+        queryStack.clear();
+        queryStack.push_back(root);
+        while (!queryStack.empty())
+        {
+            const int index = queryStack.back();
+            queryStack.pop_back();
+
+            const Node& node = nodes[index];
+            if (!Overlaps(query.boundsMin, query.boundsMax, node.fatMin, node.fatMax))
+                continue;
+
+            if (node.IsLeaf())
+            {
+                //both leaves find each other, only the lower index reports
+                if (index > leaf && Overlaps(query.boundsMin, query.boundsMax, node.boundsMin, node.boundsMax))
+                    outPairs.emplace_back(query.object, node.object);
+                continue;
+            }
+
+            queryStack.push_back(node.child1);
+            queryStack.push_back(node.child2);
+        }
+    }
+}
+
+void DynamicAABBTree::QueryAABB(const glm::vec2& boundsMin, const glm::vec2& boundsMax, std::vector<Object*>& outObjects)
+{
+    if (root == NULL_NODE)
+        return;
+
+    queryStack.clear();
+    queryStack.push_back(root);
+    while (!queryStack.empty())
+    {
+        const int index = queryStack.back();
+        queryStack.pop_back();
+
+        const Node& node = nodes[index];
+        if (!Overlaps(boundsMin, boundsMax, node.fatMin, node.fatMax))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            if (Overlaps(boundsMin, boundsMax, node.boundsMin, node.boundsMax))
+                outObjects.push_back(node.object);
+            continue;
+        }
+
+        queryStack.push_back(node.child1);
+        queryStack.push_back(node.child2);
+    }
+}
+
+void DynamicAABBTree::Reset()
+{
+    nodes.clear();
+    root = NULL_NODE;
+    freeList = NULL_NODE;
+    leafOf.clear();
+    leaves.clear();
+}
+
+int DynamicAABBTree::AllocateNode()
+{
+    if (freeList == NULL_NODE)
+    {
+        nodes.emplace_back();
+        return static_cast<int>(nodes.size() - 1);
+    }
+
+    const int node = freeList;
+    freeList = nodes[node].parent;
+    nodes[node] = Node{};
+    return node;
+}
+
+void DynamicAABBTree::FreeNode(int node)
+{
+    nodes[node] = Node{};
+    nodes[node].parent = freeList;
+    freeList = node;
+}
+
+void DynamicAABBTree::InsertLeaf(int leaf)
+{
+    if (root == NULL_NODE)
+    {
+        root = leaf;
+        nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    const glm::vec2 leafMin = nodes[leaf].fatMin;
+    const glm::vec2 leafMax = nodes[leaf].fatMax;
+
+    //descend towards the sibling with the lowest surface area heuristic cost
+    int index = root;
+    while (!nodes[index].IsLeaf())
+    {
+        const Node& node = nodes[index];
+        const float area = Perimeter(node.fatMin, node.fatMax);
+        const float combinedArea = Perimeter(glm::min(node.fatMin, leafMin), glm::max(node.fatMax, leafMax));
+
+        //cost of pairing the leaf with this node, and the growth every child option pushes onto this node
+        const float cost = 2.f * combinedArea;
+        const float inheritanceCost = 2.f * (combinedArea - area);
+
+        auto childCost = [&](int child)
+            {
+                const Node& c = nodes[child];
+                const float enlarged = Perimeter(glm::min(c.fatMin, leafMin), glm::max(c.fatMax, leafMax));
+                return (c.IsLeaf() ? enlarged : enlarged - Perimeter(c.fatMin, c.fatMax)) + inheritanceCost;
+            };
+        const float cost1 = childCost(node.child1);
+        const float cost2 = childCost(node.child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const int sibling = index;
+    const int oldParent = nodes[sibling].parent;
+    const int newParent = AllocateNode();
+
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+    Refit(newParent);
+
+    if (oldParent == NULL_NODE)
+        root = newParent;
+    else if (nodes[oldParent].child1 == sibling)
+        nodes[oldParent].child1 = newParent;
+    else
+        nodes[oldParent].child2 = newParent;
+
+    for (int node = oldParent; node != NULL_NODE; node = nodes[node].parent)
+    {
+        node = Balance(node);
+        Refit(node);
+    }
+}
+
+void DynamicAABBTree::RemoveLeaf(int leaf)
+{
+    if (leaf == root)
+    {
+        root = NULL_NODE;
+        return;
+    }
+
+    const int parent = nodes[leaf].parent;
+    const int grandParent = nodes[parent].parent;
+    const int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    FreeNode(parent);
+    nodes[sibling].parent = grandParent;
+
+    if (grandParent == NULL_NODE)
+    {
+        root = sibling;
+        return;
+    }
+
+    if (nodes[grandParent].child1 == parent)
+        nodes[grandParent].child1 = sibling;
+    else
+        nodes[grandParent].child2 = sibling;
+
+    for (int node = grandParent; node != NULL_NODE; node = nodes[node].parent)
+    {
+        node = Balance(node);
+        Refit(node);
+    }
+}
+
+void DynamicAABBTree::RemoveProxy(int leaf)
+{
+    RemoveLeaf(leaf);
+    leafOf.erase(nodes[leaf].object);
+
+    const uint32_t slot = nodes[leaf].leafSlot;
+    leaves[slot] = leaves.back();
+    nodes[leaves[slot]].leafSlot = slot;
+    leaves.pop_back();
+
+    FreeNode(leaf);
+}
+
+void DynamicAABBTree::Refit(int node)
+{
+    Node& n = nodes[node];
+    const Node& a = nodes[n.child1];
+    const Node& b = nodes[n.child2];
+    n.fatMin = glm::min(a.fatMin, b.fatMin);
+    n.fatMax = glm::max(a.fatMax, b.fatMax);
+    n.height = 1 + std::max(a.height, b.height);
+}
+
+int DynamicAABBTree::Balance(int a)
+{
+    if (nodes[a].IsLeaf() || nodes[a].height < 2)
+        return a;
+
+    const int b = nodes[a].child1;
+    const int c = nodes[a].child2;
+    const int balance = nodes[c].height - nodes[b].height;
+    if (balance >= -1 && balance <= 1)
+        return a;
+
+    //rotate the taller child up into a's place; a keeps the shorter child and one grandchild
+    const int up = balance > 1 ? c : b;
+    const int upChild1 = nodes[up].child1;
+    const int upChild2 = nodes[up].child2;
+
+    nodes[up].child1 = a;
+    nodes[up].parent = nodes[a].parent;
+    nodes[a].parent = up;
+
+    if (nodes[up].parent == NULL_NODE)
+        root = up;
+    else if (nodes[nodes[up].parent].child1 == a)
+        nodes[nodes[up].parent].child1 = up;
+    else
+        nodes[nodes[up].parent].child2 = up;
+
+    //the taller grandchild stays with up, the other replaces up under a
+    const bool isChild1Taller = nodes[upChild1].height > nodes[upChild2].height;
+    const int keep = isChild1Taller ? upChild1 : upChild2;
+    const int moved = isChild1Taller ? upChild2 : upChild1;
+
+    nodes[up].child2 = keep;
+    if (up == c)
+        nodes[a].child2 = moved;
+    else
+        nodes[a].child1 = moved;
+    nodes[moved].parent = a;
+
+    Refit(a);
+    Refit(up);
+    return up;
+}
+
+void DynamicAABBTree::Fatten(Node& leaf) const
+{
+    const glm::vec2 margin = glm::vec2(fatMargin) + (leaf.boundsMax - leaf.boundsMin) * fatMarginScale;
+    leaf.fatMin = leaf.boundsMin - margin;
+    leaf.fatMax = leaf.boundsMax + margin;
+}
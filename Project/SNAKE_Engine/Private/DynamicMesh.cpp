@@ -0,0 +1,174 @@
+#include "Engine.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "gl.h"
+
+DynamicMesh::DynamicMesh(GLsizei vertexCapacity_, GLsizei indexCapacity_, PrimitiveType primitiveType_, const VertexLayout& layout_)
+    : Mesh(primitiveType_, layout_), vertexCapacity(std::max<GLsizei>(vertexCapacity_, 1)), indexCapacity(std::max<GLsizei>(indexCapacity_, 1))
+{
+    useShortIndex = vertexCapacity <= 0x10000;
+
+    glCreateVertexArrays(1, &vao);
+
+    glCreateBuffers(1, &vbo);
+    glNamedBufferData(vbo, static_cast<GLsizeiptr>(vertexCapacity) * layout.GetStride(), nullptr, GL_DYNAMIC_DRAW);
+    layout.SetupAttributes(vao, vbo);
+
+    glCreateBuffers(1, &ebo);
+    glNamedBufferData(ebo, static_cast<GLsizeiptr>(indexCapacity) * (useShortIndex ? sizeof(uint16_t) : sizeof(uint32_t)), nullptr, GL_DYNAMIC_DRAW);
+    glVertexArrayElementBuffer(vao, ebo);
+}
+
+Vertex* DynamicMesh::MapVertices(GLsizei vertexCount_)
+{
+    vertices.resize(vertexCount_);
+    MarkVerticesDirty(0, vertexCount_);
+    return vertices.data();
+}
+
+unsigned int* DynamicMesh::MapIndices(GLsizei indexCount_)
+{
+    indices.resize(indexCount_);
+    MarkIndicesDirty(0, indexCount_);
+    return indices.data();
+}
+
+void DynamicMesh::WriteVertices(GLsizei offset, const std::vector<Vertex>& source)
+{
+    GLsizei end = offset + static_cast<GLsizei>(source.size());
+    if (end > static_cast<GLsizei>(vertices.size()))
+        vertices.resize(end);
+    std::copy(source.begin(), source.end(), vertices.begin() + offset);
+    MarkVerticesDirty(offset, end);
+}
+
+void DynamicMesh::WriteIndices(GLsizei offset, const std::vector<unsigned int>& source)
+{
+    GLsizei end = offset + static_cast<GLsizei>(source.size());
+    if (end > static_cast<GLsizei>(indices.size()))
+        indices.resize(end);
+    std::copy(source.begin(), source.end(), indices.begin() + offset);
+    MarkIndicesDirty(offset, end);
+}
+
+void DynamicMesh::SetGeometry(const std::vector<Vertex>& vertices_, const std::vector<unsigned int>& indices_)
+{
+    vertices = vertices_;
+    indices = indices_;
+    MarkVerticesDirty(0, static_cast<GLsizei>(vertices.size()));
+    MarkIndicesDirty(0, static_cast<GLsizei>(indices.size()));
+    Commit();
+}
+
+void DynamicMesh::Commit()
+{
+    const GLsizei usedVertices = static_cast<GLsizei>(vertices.size());
+    const GLsizei usedIndices = static_cast<GLsizei>(indices.size());
+
+    if (Reserve(usedVertices, usedIndices))
+    {
+        MarkVerticesDirty(0, usedVertices);
+        MarkIndicesDirty(0, usedIndices);
+    }
+
+    dirtyVertexEnd = std::min(dirtyVertexEnd, usedVertices);
+    dirtyIndexEnd = std::min(dirtyIndexEnd, usedIndices);
+
+    if (dirtyVertexBegin < dirtyVertexEnd)
+    {
+        //a full rewrite orphans the old storage so the driver never waits on frames still reading it
+        if (dirtyVertexBegin == 0 && dirtyVertexEnd == usedVertices)
+            glNamedBufferData(vbo, static_cast<GLsizeiptr>(vertexCapacity) * layout.GetStride(), nullptr, GL_DYNAMIC_DRAW);
+        UploadVertices(dirtyVertexBegin, dirtyVertexEnd);
+        ComputeLocalBounds(vertices);
+    }
+    if (dirtyIndexBegin < dirtyIndexEnd)
+    {
+        if (dirtyIndexBegin == 0 && dirtyIndexEnd == usedIndices)
+            glNamedBufferData(ebo, static_cast<GLsizeiptr>(indexCapacity) * (useShortIndex ? sizeof(uint16_t) : sizeof(uint32_t)), nullptr, GL_DYNAMIC_DRAW);
+        UploadIndices(dirtyIndexBegin, dirtyIndexEnd);
+    }
+
+    dirtyVertexBegin = dirtyVertexEnd = 0;
+    dirtyIndexBegin = dirtyIndexEnd = 0;
+
+    useIndex = usedIndices > 0;
+    indexCount = useIndex ? usedIndices : usedVertices;
+}
+
+void DynamicMesh::MarkVerticesDirty(GLsizei begin, GLsizei end)
+{
+    if (begin >= end)
+        return;
+    if (dirtyVertexBegin == dirtyVertexEnd)
+    {
+        dirtyVertexBegin = begin;
+        dirtyVertexEnd = end;
+        return;
+    }
+    dirtyVertexBegin = std::min(dirtyVertexBegin, begin);
+    dirtyVertexEnd = std::max(dirtyVertexEnd, end);
+}
+
+void DynamicMesh::MarkIndicesDirty(GLsizei begin, GLsizei end)
+{
+    if (begin >= end)
+        return;
+    if (dirtyIndexBegin == dirtyIndexEnd)
+    {
+        dirtyIndexBegin = begin;
+        dirtyIndexEnd = end;
+        return;
+    }
+    dirtyIndexBegin = std::min(dirtyIndexBegin, begin);
+    dirtyIndexEnd = std::max(dirtyIndexEnd, end);
+}
+
+bool DynamicMesh::Reserve(GLsizei requiredVertices, GLsizei requiredIndices)
+{
+    bool isResized = false;
+
+    //storage is re-specified on the same buffer names, so the VAO bindings stay valid across growth
+    if (requiredVertices > vertexCapacity)
+    {
+        vertexCapacity = std::max(requiredVertices, vertexCapacity * 2);
+        glNamedBufferData(vbo, static_cast<GLsizeiptr>(vertexCapacity) * layout.GetStride(), nullptr, GL_DYNAMIC_DRAW);
+        isResized = true;
+    }
+
+    const bool wasShortIndex = useShortIndex;
+    useShortIndex = vertexCapacity <= 0x10000;
+    if (requiredIndices > indexCapacity || wasShortIndex != useShortIndex)
+    {
+        indexCapacity = std::max(requiredIndices, indexCapacity * 2);
+        glNamedBufferData(ebo, static_cast<GLsizeiptr>(indexCapacity) * (useShortIndex ? sizeof(uint16_t) : sizeof(uint32_t)), nullptr, GL_DYNAMIC_DRAW);
+        isResized = true;
+    }
+    return isResized;
+}
+
+void DynamicMesh::UploadVertices(GLsizei begin, GLsizei end)
+{
+    const GLsizei stride = layout.GetStride();
+    layout.PackVertices(vertices.data() + begin, static_cast<size_t>(end - begin), packed);
+    glNamedBufferSubData(vbo, static_cast<GLintptr>(begin) * stride, packed.size(), packed.data());
+}
+
+void DynamicMesh::UploadIndices(GLsizei begin, GLsizei end)
+{
+    const size_t count = static_cast<size_t>(end - begin);
+    if (useShortIndex)
+    {
+        packed.resize(count * sizeof(uint16_t));
+        uint16_t* dst = reinterpret_cast<uint16_t*>(packed.data());
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = static_cast<uint16_t>(indices[begin + i]);
+        glNamedBufferSubData(ebo, static_cast<GLintptr>(begin) * sizeof(uint16_t), packed.size(), packed.data());
+    }
+    else
+    {
+        glNamedBufferSubData(ebo, static_cast<GLintptr>(begin) * sizeof(uint32_t), count * sizeof(uint32_t), indices.data() + begin);
+    }
+}
@@ -1,10 +1,12 @@
 #include "Engine.h"
 
 #include <algorithm>
+#include <fstream>
 #include <sstream>
 #include <unordered_set>
 
 #include "gl.h"
+#include FT_ADVANCES_H
 
 static std::vector<char32_t> UTF8ToCodepoints(const std::string& text)
 {
@@ -56,148 +58,122 @@ static std::vector<char32_t> UTF8ToCodepoints(const std::string& text)
 
 
 Font::Font(RenderManager& renderManager, const std::string& ttfPath, uint32_t fontSize_)
+    : rasterizer(&renderManager.glyphRasterizer), atlas(&renderManager.glyphAtlas), fontSize(fontSize_)
 {
-    LoadFont(ttfPath, fontSize_);
-    BakeAtlas(renderManager);
-    fontSize = fontSize_;
+    LoadFont(ttfPath);
+    BakeFallbackGlyph();
 }
 
 Font::~Font()
 {
-    FT_Done_Face(face);
-    FT_Done_FreeType(ft);
+    rasterizer->ReleaseFont(this);
+    rasterizer->CloseFace(face);
+    atlas->Release(this);
 }
 
-void Font::LoadFont(const std::string& path, uint32_t fontSize)
+Material* Font::GetMaterial() const
 {
-    if (FT_Init_FreeType(&ft))
-        throw std::runtime_error("Failed to init FreeType");
-
-    if (FT_New_Face(ft, path.c_str(), 0, &face))
-        throw std::runtime_error("Failed to load font: " + path);
+    return atlas->GetMaterial();
+}
 
-    FT_Set_Pixel_Sizes(face, 0, fontSize);
+int Font::GetTextAtlasVersion() const
+{
+    return atlas->GetVersion();
 }
 
-void Font::BakeAtlas(RenderManager& renderManager)
+void Font::LoadFont(const std::string& path)
 {
-    int texWidth = 128;
-    int texHeight = 128;
-    std::vector<unsigned char> pixels(texWidth * texHeight, 0);
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        throw std::runtime_error("Failed to load font: " + path);
 
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    atlasTexture = std::make_unique<Texture>(pixels.data(), texWidth, texHeight, 1);
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    fontData.resize(static_cast<size_t>(size));
+    if (!file.read(reinterpret_cast<char*>(fontData.data()), size))
+        throw std::runtime_error("Failed to load font: " + path);
 
-    Shader* textShader = renderManager.GetShaderByTag("[EngineShader]internal_text");
-    material = std::make_unique<Material>(textShader);
-    material->SetTexture("u_FontTexture", atlasTexture.get());
-    material->SetUniform("u_Color", glm::vec4(1.0f));
+    face = rasterizer->OpenFace(*this);
+    if (!face)
+        throw std::runtime_error("Failed to load font: " + path);
+}
 
-    nextX = 0;
-    nextY = 0;
-    maxRowHeight = 0;
+void Font::BakeFallbackGlyph()
+{
+    //fallback glyph has to be resident before any async request can fall back to it
+    if (!TryBakeGlyph(U'?'))
+    {
+        SNAKE_WRN("Failed to bake fallback glyph");
+    }
 }
 
 bool Font::TryBakeGlyph(char32_t c)
 {
-    if (glyphs.find(c) != glyphs.end())
+    const Glyph* existing = atlas->Find({ this, fontSize, c });
+    if (existing && existing->isResident)
         return true;
 
-    if (FT_Load_Char(face, c, FT_LOAD_RENDER))
+    RasterizedGlyph rasterized;
+    rasterized.font = this;
+    if (!GlyphRasterizer::Rasterize(face, c, rasterized))
     {
         SNAKE_ERR("FT_Load_Char failed for: U+" << std::hex << (int)c);
         return false;
     }
 
-    FT_GlyphSlot g = face->glyph;
-    int w = g->bitmap.width;
-    int h = g->bitmap.rows;
-    bool hasBitmap = (w > 0 && h > 0);
-    bool hasAdvance = (g->advance.x > 0);
+    atlas->Pack({ this, fontSize, c }, rasterized);
+    return true;
+}
 
-    if (!hasBitmap && !hasAdvance)
-    {
-        SNAKE_WRN("Glyph has no bitmap or advance: U+" << std::hex << (int)c);
-        return false;
-    }
+bool Font::RequestGlyph(char32_t c)
+{
+    const Glyph* existing = atlas->Find({ this, fontSize, c });
+    if (existing)
+        return existing->isResident;
 
-    const int padding = 1;
-    const int safeW = std::max(1, w);
-    const int safeH = std::max(1, h);
-    const int cellW = safeW + padding * 2;
-    const int cellH = safeH + padding * 2;
+    if (failedGlyphs.find(c) != failedGlyphs.end())
+        return true;
 
-    if (nextX + cellW > atlasTexture->GetWidth())
+    if (!rasterizer->IsRunning())
     {
-        nextX = 0;
-        nextY += maxRowHeight;
-        maxRowHeight = 0;
+        if (!TryBakeGlyph(c))
+            failedGlyphs.insert(c);
+        return true;
     }
 
-    if (nextY + cellH > atlasTexture->GetHeight())
-    {
-        ExpandAtlas();
-        return TryBakeGlyph(c);
-    }
+    //advance is cheap to query, so layout stays correct while the bitmap is rasterized on a worker
+    FT_Fixed advance = 0;
+    if (FT_Get_Advance(face, FT_Get_Char_Index(face, c), FT_LOAD_DEFAULT, &advance))
+        advance = 0;
 
-    int drawX = nextX + padding;
-    int drawY = nextY + padding;
+    atlas->SetPlaceholder({ this, fontSize, c }, static_cast<uint32_t>(advance >> 10));
 
-    if (hasBitmap && g->bitmap.buffer)
-    {
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-        glTextureSubImage2D(
-            atlasTexture->GetID(), 0,
-            drawX, drawY, w, h,
-            GL_RED, GL_UNSIGNED_BYTE,
-            g->bitmap.buffer
-        );
-    }
-    else
+    rasterizer->Request(this, c);
+    return false;
+}
+
+void Font::CommitGlyph(const RasterizedGlyph& rasterized)
+{
+    if (!rasterized.isValid)
     {
-        unsigned char dummy = 0;
-        glTextureSubImage2D(
-            atlasTexture->GetID(), 0,
-            drawX, drawY, 1, 1,
-            GL_RED, GL_UNSIGNED_BYTE,
-            &dummy
-        );
+        SNAKE_WRN("Glyph has no bitmap or advance: U+" << std::hex << (int)rasterized.codepoint);
+        atlas->Erase({ this, fontSize, rasterized.codepoint });
+        failedGlyphs.insert(rasterized.codepoint);
+        return;
     }
 
-    Glyph glyph;
-    glyph.size = { w, h };
-    glyph.bearing = { g->bitmap_left, g->bitmap_top };
-    glyph.advance = g->advance.x;
-
-    glyph.uvTopLeft = {
-        static_cast<float>(drawX) / atlasTexture->GetWidth(),
-        static_cast<float>(drawY) / atlasTexture->GetHeight()
-    };
-    glyph.uvBottomRight = {
-        static_cast<float>(drawX + safeW) / atlasTexture->GetWidth(),
-        static_cast<float>(drawY + safeH) / atlasTexture->GetHeight()
-    };
-
-    glyphs[c] = glyph;
-
-    nextX += cellW;
-    maxRowHeight = std::max(maxRowHeight, cellH);
-
-    return true;
+    atlas->Pack({ this, fontSize, rasterized.codepoint }, rasterized);
 }
 
-
 const Glyph& Font::GetGlyph(char32_t c) const
 {
-    auto it = glyphs.find(c);
-    if (it != glyphs.end())
-        return it->second;
+    if (const Glyph* glyph = atlas->Find({ this, fontSize, c }))
+        return *glyph;
 
     static const char32_t fallbackCodepoint = U'?';
 
-    auto fallbackIt = glyphs.find(fallbackCodepoint);
-    if (fallbackIt != glyphs.end())
-        return fallbackIt->second;
+    if (const Glyph* fallback = atlas->Find({ this, fontSize, fallbackCodepoint }))
+        return *fallback;
 
     static Glyph empty{};
     return empty;
@@ -230,10 +206,18 @@ glm::vec2 Font::GetTextSize(const std::string& text) const
     return { maxWidth, totalHeight };
 }
 
-Mesh* Font::GenerateTextMesh(const std::string& text, TextAlignH alignH, TextAlignV alignV)
+Mesh* Font::GenerateTextMesh(const std::string& text, TextAlignH alignH, TextAlignV alignV, bool* hasPendingGlyphs)
 {
     std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
+    std::vector<unsigned int> indices;
+    BuildTextGeometry(text, alignH, alignV, vertices, indices, hasPendingGlyphs);
+    return new Mesh(vertices, indices, PrimitiveType::Triangles, TEXT_VERTEX_LAYOUT);
+}
+
+void Font::BuildTextGeometry(const std::string& text, TextAlignH alignH, TextAlignV alignV, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, bool* hasPendingGlyphs)
+{
+    vertices.clear();
+    indices.clear();
     uint32_t indexOffset = 0;
 
     std::stringstream ss(text);
@@ -245,17 +229,16 @@ Mesh* Font::GenerateTextMesh(const std::string& text, TextAlignH alignH, TextAli
     float lineSpacing = static_cast<float>(fontSize);
     size_t lineCount = lines.size();
 
+    bool isPending = false;
     std::vector<float> lineWidths;
     float maxLineWidth = 0.0f;
     for (const std::string& lineText : lines)
     {
         std::vector<char32_t> u32Line = UTF8ToCodepoints(lineText);
-        //pre-bake for calculating width
+        //request missing glyphs up front; their advances are known even before the bitmaps land
         for (char32_t c : u32Line)
-            if (!TryBakeGlyph(c))
-            {
-                SNAKE_WRN("Failed to bake glyph");
-            }
+            if (!RequestGlyph(c))
+                isPending = true;
 
         float lineWidth = 0.0f;
         for (char32_t c : u32Line)
@@ -290,11 +273,12 @@ Mesh* Font::GenerateTextMesh(const std::string& text, TextAlignH alignH, TextAli
         std::vector<char32_t> u32 = UTF8ToCodepoints(lineText);
         for (char32_t c : u32)
         {
-            if (!TryBakeGlyph(c))
+            const Glyph& glyph = GetGlyph(c);
+            if (!glyph.isResident)
             {
-                SNAKE_WRN("Failed to bake glyph");
+                xCursor += static_cast<float>(glyph.advance >> 6);
+                continue;
             }
-            const Glyph& glyph = GetGlyph(c);
             float xpos = xCursor + (float)glyph.bearing.x;
             float ypos = yCursor - (float)(glyph.size.y - glyph.bearing.y);
             float w = (float)glyph.size.x;
@@ -323,36 +307,6 @@ Mesh* Font::GenerateTextMesh(const std::string& text, TextAlignH alignH, TextAli
         yCursor -= lineSpacing;
     }
 
-    return new Mesh(vertices, indices);
-}
-
-
-void Font::ExpandAtlas()
-{
-    int oldWidth = atlasTexture->GetWidth();
-    int oldHeight = atlasTexture->GetHeight();
-
-    int newWidth = oldWidth * 2;
-    int newHeight = oldHeight * 2;
-
-    std::vector<unsigned char> newPixels(newWidth * newHeight, 0);
-    std::unique_ptr<Texture> newAtlas = std::make_unique<Texture>(newPixels.data(), newWidth, newHeight, 1);
-    material->SetTexture("u_FontTexture", newAtlas.get());
-    atlasTexture = std::move(newAtlas);
-
-    nextX = 0;
-    nextY = 0;
-    maxRowHeight = 0;
-
-    std::unordered_map<char32_t, Glyph> oldGlyphs = glyphs;
-    glyphs.clear();
-
-    for (const auto& [c, _] : oldGlyphs)
-    {
-        if (!TryBakeGlyph(c))
-        {
-            SNAKE_WRN("Failed to bake glyph");
-        }
-    }
-    atlasVersion++;
+    if (hasPendingGlyphs)
+        *hasPendingGlyphs = isPending;
 }
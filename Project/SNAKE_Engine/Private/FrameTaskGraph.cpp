@@ -0,0 +1,90 @@
+#include "Engine.h"
+
+#include <iomanip>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    float ToMilliseconds(Clock::duration duration)
+    {
+        return std::chrono::duration<float, std::milli>(duration).count();
+    }
+}
+
+FrameStageID FrameTaskGraph::AddStage(const std::string& name, std::function<void()> function, const std::vector<FrameStageID>& dependencies, bool isMainThreadOnly)
+{
+    for (FrameStageID dependency : dependencies)
+    {
+        if (dependency >= stages.size())
+        {
+            SNAKE_ERR("[FrameTaskGraph] stage \"" << name << "\" depends on a stage that was not added before it");
+            return stages.size();
+        }
+    }
+
+    stages.push_back({ name, std::move(function), dependencies, isMainThreadOnly });
+    return stages.size() - 1;
+}
+
+void FrameTaskGraph::Clear()
+{
+    stages.clear();
+    handles.clear();
+    runningTimings.clear();
+    timings.clear();
+    frameMilliseconds = 0.f;
+}
+
+void FrameTaskGraph::Run(JobSystem& jobSystem)
+{
+    const Clock::time_point frameStart = Clock::now();
+
+    handles.clear();
+    runningTimings.resize(stages.size());
+
+    std::vector<JobHandle> dependencyHandles;
+    for (FrameStageID id = 0; id < stages.size(); ++id)
+    {
+        const Stage& stage = stages[id];
+
+        dependencyHandles.clear();
+        for (FrameStageID dependency : stage.dependencies)
+            dependencyHandles.push_back(handles[dependency]);
+
+        //each stage only writes its own timing slot, so no lock is needed
+        auto job = [this, id, frameStart, &jobSystem]()
+            {
+                const Clock::time_point stageStart = Clock::now();
+                stages[id].function();
+                FrameStageTiming& timing = runningTimings[id];
+                timing.name = stages[id].name;
+                timing.startMilliseconds = ToMilliseconds(stageStart - frameStart);
+                timing.durationMilliseconds = ToMilliseconds(Clock::now() - stageStart);
+                timing.ranOnMainThread = jobSystem.IsMainThread();
+            };
+
+        if (stage.isMainThreadOnly)
+            handles.push_back(jobSystem.ScheduleFrameStage(job, dependencyHandles));
+        else
+            handles.push_back(jobSystem.Schedule(job, dependencyHandles));
+    }
+
+    for (const JobHandle& handle : handles)
+        jobSystem.WaitForFrameStage(handle);
+
+    frameMilliseconds = ToMilliseconds(Clock::now() - frameStart);
+    std::swap(timings, runningTimings);
+}
+
+void FrameTaskGraph::LogTimings() const
+{
+    std::ostringstream report;
+    report << "[FrameTaskGraph] frame " << std::fixed << std::setprecision(3) << frameMilliseconds << "ms";
+    for (const FrameStageTiming& timing : timings)
+    {
+        report << "\n    " << timing.name << ": +" << timing.startMilliseconds << "ms, "
+            << timing.durationMilliseconds << "ms" << (timing.ranOnMainThread ? "" : " (worker)");
+    }
+    SNAKE_LOG(report.str());
+}
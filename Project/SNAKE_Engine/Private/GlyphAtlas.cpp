@@ -0,0 +1,156 @@
+#include "Engine.h"
+
+#include <algorithm>
+
+#include "gl.h"
+
+void GlyphAtlas::Init(RenderManager& renderManager)
+{
+    int texWidth = 256;
+    int texHeight = 256;
+    std::vector<unsigned char> pixels(texWidth * texHeight, 0);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    texture = std::make_unique<Texture>(pixels.data(), texWidth, texHeight, 1);
+
+    Shader* textShader = renderManager.GetShaderByTag("[EngineShader]internal_text");
+    material = std::make_unique<Material>(textShader);
+    material->SetTexture("u_FontTexture", texture.get());
+    material->SetUniform("u_Color", glm::vec4(1.0f));
+
+    nextX = 0;
+    nextY = 0;
+    maxRowHeight = 0;
+}
+
+const Glyph* GlyphAtlas::Find(const GlyphKey& key) const
+{
+    auto it = glyphs.find(key);
+    return it != glyphs.end() ? &it->second : nullptr;
+}
+
+void GlyphAtlas::SetPlaceholder(const GlyphKey& key, uint32_t advance)
+{
+    Glyph placeholder{};
+    placeholder.advance = advance;
+    placeholder.isResident = false;
+    glyphs[key] = placeholder;
+}
+
+void GlyphAtlas::Pack(const GlyphKey& key, const RasterizedGlyph& rasterized)
+{
+    const int w = rasterized.size.x;
+    const int h = rasterized.size.y;
+    const bool hasBitmap = !rasterized.bitmap.empty();
+
+    const int padding = 1;
+    const int safeW = std::max(1, w);
+    const int safeH = std::max(1, h);
+    const int cellW = safeW + padding * 2;
+    const int cellH = safeH + padding * 2;
+
+    if (nextX + cellW > texture->GetWidth())
+    {
+        nextX = 0;
+        nextY += maxRowHeight;
+        maxRowHeight = 0;
+    }
+
+    while (nextY + cellH > texture->GetHeight() || nextX + cellW > texture->GetWidth())
+        Expand();
+
+    int drawX = nextX + padding;
+    int drawY = nextY + padding;
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (hasBitmap)
+    {
+        glTextureSubImage2D(
+            texture->GetID(), 0,
+            drawX, drawY, w, h,
+            GL_RED, GL_UNSIGNED_BYTE,
+            rasterized.bitmap.data()
+        );
+    }
+    else
+    {
+        unsigned char dummy = 0;
+        glTextureSubImage2D(
+            texture->GetID(), 0,
+            drawX, drawY, 1, 1,
+            GL_RED, GL_UNSIGNED_BYTE,
+            &dummy
+        );
+    }
+
+    Glyph glyph;
+    glyph.size = { w, h };
+    glyph.bearing = rasterized.bearing;
+    glyph.advance = rasterized.advance;
+    glyph.isResident = true;
+
+    glyph.uvTopLeft = {
+        static_cast<float>(drawX) / texture->GetWidth(),
+        static_cast<float>(drawY) / texture->GetHeight()
+    };
+    glyph.uvBottomRight = {
+        static_cast<float>(drawX + safeW) / texture->GetWidth(),
+        static_cast<float>(drawY + safeH) / texture->GetHeight()
+    };
+
+    glyphs[key] = glyph;
+
+    nextX += cellW;
+    maxRowHeight = std::max(maxRowHeight, cellH);
+}
+
+void GlyphAtlas::Erase(const GlyphKey& key)
+{
+    glyphs.erase(key);
+}
+
+void GlyphAtlas::Release(const Font* font)
+{
+    //atlas space is not reclaimed; the cells are simply orphaned until the atlas is rebuilt
+    for (auto it = glyphs.begin(); it != glyphs.end();)
+    {
+        if (it->first.font == font)
+            it = glyphs.erase(it);
+        else
+            ++it;
+    }
+}
+
+void GlyphAtlas::Expand()
+{
+    int oldWidth = texture->GetWidth();
+    int oldHeight = texture->GetHeight();
+
+    int newWidth = oldWidth * 2;
+    int newHeight = oldHeight * 2;
+
+    std::vector<unsigned char> newPixels(newWidth * newHeight, 0);
+    std::unique_ptr<Texture> newTexture = std::make_unique<Texture>(newPixels.data(), newWidth, newHeight, 1);
+
+    //copy the old atlas on the GPU instead of re-rasterizing every glyph; packing continues where it left off
+    glCopyImageSubData(
+        texture->GetID(), GL_TEXTURE_2D, 0, 0, 0, 0,
+        newTexture->GetID(), GL_TEXTURE_2D, 0, 0, 0, 0,
+        oldWidth, oldHeight, 1);
+
+    material->SetTexture("u_FontTexture", newTexture.get());
+    texture = std::move(newTexture);
+
+    glm::vec2 uvScale = {
+        static_cast<float>(oldWidth) / newWidth,
+        static_cast<float>(oldHeight) / newHeight
+    };
+    for (auto& [key, glyph] : glyphs)
+    {
+        if (!glyph.isResident)
+            continue;
+        glyph.uvTopLeft *= uvScale;
+        glyph.uvBottomRight *= uvScale;
+    }
+    version++;
+}
@@ -0,0 +1,218 @@
+#include "Engine.h"
+
+#include <algorithm>
+#include <cstring>
+
+GlyphRasterizer::~GlyphRasterizer()
+{
+    Shutdown();
+}
+
+bool GlyphRasterizer::Rasterize(FT_Face face, char32_t codepoint, RasterizedGlyph& out)
+{
+    out.codepoint = codepoint;
+    out.isValid = false;
+
+    if (!face || FT_Load_Char(face, codepoint, FT_LOAD_RENDER))
+        return false;
+
+    FT_GlyphSlot g = face->glyph;
+    int w = static_cast<int>(g->bitmap.width);
+    int h = static_cast<int>(g->bitmap.rows);
+    bool hasBitmap = (w > 0 && h > 0 && g->bitmap.buffer);
+    bool hasAdvance = (g->advance.x > 0);
+
+    if (!hasBitmap && !hasAdvance)
+        return false;
+
+    out.size = { w, h };
+    out.bearing = { g->bitmap_left, g->bitmap_top };
+    out.advance = static_cast<uint32_t>(g->advance.x);
+    out.bitmap.clear();
+
+    if (hasBitmap)
+    {
+        // FreeType rows may be padded, so copy them out tightly packed for GL_UNPACK_ALIGNMENT 1
+        out.bitmap.resize(static_cast<size_t>(w) * h);
+        const int pitch = std::abs(g->bitmap.pitch);
+        for (int row = 0; row < h; ++row)
+            std::memcpy(out.bitmap.data() + static_cast<size_t>(row) * w, g->bitmap.buffer + static_cast<size_t>(row) * pitch, w);
+    }
+
+    out.isValid = true;
+    return true;
+}
+
+void GlyphRasterizer::Init(unsigned int workerCount)
+{
+    if (isRunning)
+        return;
+
+    if (workerCount == 0)
+    {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = std::clamp(hardwareThreads > 1 ? hardwareThreads - 1 : 1u, 1u, 4u);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!library && FT_Init_FreeType(&library))
+        {
+            SNAKE_ERR("Failed to init FreeType");
+            library = nullptr;
+            return;
+        }
+        workerFaces.resize(workerCount);
+        busyFonts.assign(workerCount, nullptr);
+        isRunning = true;
+    }
+
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i)
+        workers.emplace_back(&GlyphRasterizer::WorkerLoop, this, i);
+}
+
+void GlyphRasterizer::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isRunning = false;
+        jobs.clear();
+    }
+    jobAvailable.notify_all();
+
+    for (std::thread& worker : workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+    workers.clear();
+
+    for (auto& faces : workerFaces)
+    {
+        for (auto& [font, face] : faces)
+            FT_Done_Face(face);
+    }
+    workerFaces.clear();
+    busyFonts.clear();
+    results.clear();
+
+    if (library)
+    {
+        FT_Done_FreeType(library);
+        library = nullptr;
+    }
+}
+
+FT_Face GlyphRasterizer::OpenFace(const Font& font)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!library && FT_Init_FreeType(&library))
+    {
+        library = nullptr;
+        throw std::runtime_error("Failed to init FreeType");
+    }
+    return CreateFace(font);
+}
+
+void GlyphRasterizer::CloseFace(FT_Face face)
+{
+    if (!face)
+        return;
+    std::lock_guard<std::mutex> lock(mutex);
+    FT_Done_Face(face);
+}
+
+FT_Face GlyphRasterizer::CreateFace(const Font& font)
+{
+    FT_Face face = nullptr;
+    if (FT_New_Memory_Face(library, font.fontData.data(), static_cast<FT_Long>(font.fontData.size()), 0, &face))
+        return nullptr;
+
+    FT_Set_Pixel_Sizes(face, 0, font.fontSize);
+    return face;
+}
+
+void GlyphRasterizer::Request(Font* font, char32_t codepoint)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back({ font, codepoint });
+    }
+    jobAvailable.notify_one();
+}
+
+void GlyphRasterizer::ReleaseFont(const Font* font)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    jobs.erase(std::remove_if(jobs.begin(), jobs.end(),
+        [font](const GlyphJob& job) { return job.font == font; }), jobs.end());
+
+    jobFinished.wait(lock, [&]()
+        {
+            return std::find(busyFonts.begin(), busyFonts.end(), font) == busyFonts.end();
+        });
+
+    results.erase(std::remove_if(results.begin(), results.end(),
+        [font](const RasterizedGlyph& glyph) { return glyph.font == font; }), results.end());
+
+    for (auto& faces : workerFaces)
+    {
+        auto it = faces.find(font);
+        if (it != faces.end())
+        {
+            FT_Done_Face(it->second);
+            faces.erase(it);
+        }
+    }
+}
+
+void GlyphRasterizer::CollectResults(std::vector<RasterizedGlyph>& out)
+{
+    out.clear();
+    std::lock_guard<std::mutex> lock(mutex);
+    std::swap(out, results);
+}
+
+void GlyphRasterizer::WorkerLoop(size_t workerIndex)
+{
+    while (true)
+    {
+        GlyphJob job;
+        FT_Face face = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this]() { return !isRunning || !jobs.empty(); });
+            if (!isRunning)
+                return;
+
+            job = jobs.front();
+            jobs.pop_front();
+            busyFonts[workerIndex] = job.font;
+
+            // each worker keeps its own FT_Face per font; faces are not safe to share across threads
+            auto& faces = workerFaces[workerIndex];
+            auto it = faces.find(job.font);
+            if (it != faces.end())
+                face = it->second;
+            else
+            {
+                face = CreateFace(*job.font);
+                if (face)
+                    faces[job.font] = face;
+            }
+        }
+
+        RasterizedGlyph glyph;
+        glyph.font = job.font;
+        Rasterize(face, job.codepoint, glyph);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busyFonts[workerIndex] = nullptr;
+            results.push_back(std::move(glyph));
+        }
+        jobFinished.notify_all();
+    }
+}
@@ -0,0 +1,110 @@
+#include "Engine.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+void HierarchicalGrid::BeginFrame()
+{
+    entries.clear();
+    isBuilt = false;
+}
+
+void HierarchicalGrid::Insert(Object* obj, const glm::vec2& boundsMin, const glm::vec2& boundsMax)
+{
+    //levels are assigned in Build, once the size histogram of the whole frame is known
+    entries.push_back({ obj, boundsMin, boundsMax });
+}
+
+void HierarchicalGrid::Build()
+{
+    if (isBuilt)
+        return;
+    isBuilt = true;
+
+    if (fixedBaseCellSize > 0)
+        baseCellSize = fixedBaseCellSize;
+    else if (!entries.empty())
+    {
+        sizeHistogram.Clear();
+        for (const Entry& entry : entries)
+            sizeHistogram.Add(entry.boundsMin, entry.boundsMax);
+        //the finest level fits the small end of the distribution; anything larger climbs the levels
+        baseCellSize = std::clamp(sizeHistogram.GetPercentile(0.1f), SpatialHashGrid::MIN_CELL_SIZE, SpatialHashGrid::MAX_CELL_SIZE);
+    }
+
+    for (int level = 0; level < MAX_LEVELS; ++level)
+    {
+        levels[level].BeginFrame();
+        levels[level].SetCellSize(baseCellSize << level);
+        levelEntries[level].clear();
+    }
+
+    levelCount = 0;
+    for (uint32_t index = 0; index < entries.size(); ++index)
+    {
+        const Entry& entry = entries[index];
+        const int level = GetLevel(entry);
+        levels[level].Insert(entry.object, entry.boundsMin, entry.boundsMax);
+        levelEntries[level].push_back(index);
+        levelCount = std::max(levelCount, level + 1);
+    }
+
+    for (int level = 0; level < levelCount; ++level)
+        levels[level].Build();
+}
+
+void HierarchicalGrid::ComputePairs(std::vector<BroadPhasePair>& outPairs)
+{
+    Build();
+
+    for (int level = 0; level < levelCount; ++level)
+        levels[level].ComputePairs(outPairs);
+
+    //each cross-level pair is found once, by its smaller collider; it covers at most 2x2 cells of any coarser level
+    for (int level = 0; level < levelCount; ++level)
+    {
+        for (uint32_t index : levelEntries[level])
+        {
+            const Entry& entry = entries[index];
+            for (int coarser = level + 1; coarser < levelCount; ++coarser)
+            {
+                if (levelEntries[coarser].empty())
+                    continue;
+                levels[coarser].Query(entry.boundsMin, entry.boundsMax, [&outPairs, &entry](Object* other) { outPairs.emplace_back(entry.object, other); });
+            }
+        }
+    }
+}
+
+void HierarchicalGrid::QueryAABB(const glm::vec2& boundsMin, const glm::vec2& boundsMax, std::vector<Object*>& outObjects)
+{
+    for (int level = levelCount - 1; level >= 0; --level)
+    {
+        if (!levelEntries[level].empty())
+            levels[level].QueryAABB(boundsMin, boundsMax, outObjects);
+    }
+}
+
+void HierarchicalGrid::Reset()
+{
+    entries.clear();
+    for (int level = 0; level < MAX_LEVELS; ++level)
+    {
+        levels[level].Reset();
+        levelEntries[level].clear();
+    }
+    levelCount = 0;
+    isBuilt = false;
+}
+
+int HierarchicalGrid::GetLevel(const Entry& entry) const
+{
+    const glm::vec2 size = entry.boundsMax - entry.boundsMin;
+    const float cells = std::ceil(std::max(size.x, size.y) / static_cast<float>(baseCellSize));
+    if (cells <= 1.f)
+        return 0;
+    //the first level whose cells are at least as large as the collider
+    const uint32_t rounded = static_cast<uint32_t>(std::min(cells, static_cast<float>(1u << MAX_LEVELS)));
+    return std::min(static_cast<int>(std::bit_width(rounded - 1u)), MAX_LEVELS - 1);
+}
@@ -0,0 +1,387 @@
+#include "Engine.h"
+
+#include <algorithm>
+
+struct JobHandle::Job
+{
+    JobFunction function;
+    //starts at 1 so the job cannot be queued before Submit has registered every dependency
+    std::atomic<int> pendingDependencies = 1;
+    std::atomic<bool> isDone = false;
+    std::mutex dependentsMutex;
+    std::vector<std::shared_ptr<Job>> dependents;
+    bool isMainThreadOnly = false;
+    bool isFrameStage = false;
+};
+
+namespace
+{
+    constexpr size_t INVALID_QUEUE = static_cast<size_t>(-1);
+    //chunks per thread for ParallelFor; more than one so uneven chunks still balance
+    constexpr size_t CHUNKS_PER_THREAD = 4;
+
+    thread_local size_t currentQueueIndex = INVALID_QUEUE;
+}
+
+bool JobHandle::IsDone() const
+{
+    return !job || job->isDone.load(std::memory_order_acquire);
+}
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+void JobSystem::Init(unsigned int workerCount)
+{
+    if (isRunning)
+        return;
+
+    if (workerCount == 0)
+    {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1u;
+    }
+
+    mainThreadID = std::this_thread::get_id();
+    currentQueueIndex = 0;
+
+    queues.clear();
+    for (size_t i = 0; i < workerCount + 1; ++i)
+        queues.push_back(std::make_unique<WorkQueue>());
+
+    isRunning = true;
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i)
+        workers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+
+    SNAKE_LOG("[JobSystem] started " << workerCount << " worker threads");
+}
+
+void JobSystem::Shutdown()
+{
+    if (!isRunning)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        isRunning = false;
+    }
+    jobAvailable.notify_all();
+
+    for (std::thread& worker : workers)
+        if (worker.joinable())
+            worker.join();
+    workers.clear();
+
+    queues.clear();
+    queuedJobCount = 0;
+
+    std::lock_guard<std::mutex> lock(mainThreadMutex);
+    if (!mainThreadJobs.empty())
+        SNAKE_WRN("[JobSystem] dropping " << mainThreadJobs.size() << " main thread jobs on shutdown");
+    mainThreadJobs.clear();
+    frameStageJobs.clear();
+}
+
+JobHandle JobSystem::Schedule(JobFunction function, const std::vector<JobHandle>& dependencies)
+{
+    return Submit(std::move(function), dependencies, false);
+}
+
+JobHandle JobSystem::ScheduleOnMainThread(JobFunction function, const std::vector<JobHandle>& dependencies)
+{
+    return Submit(std::move(function), dependencies, true);
+}
+
+JobHandle JobSystem::ScheduleFrameStage(JobFunction function, const std::vector<JobHandle>& dependencies)
+{
+    return Submit(std::move(function), dependencies, true, true);
+}
+
+JobHandle JobSystem::Submit(JobFunction function, const std::vector<JobHandle>& dependencies, bool isMainThreadOnly, bool isFrameStage)
+{
+    auto job = std::make_shared<JobHandle::Job>();
+    job->function = std::move(function);
+    job->isMainThreadOnly = isMainThreadOnly;
+    job->isFrameStage = isFrameStage;
+
+    for (const JobHandle& dependency : dependencies)
+    {
+        if (!dependency.job)
+            continue;
+
+        //isDone is only flipped under this lock, so the job is either registered or the dependency has finished
+        std::lock_guard<std::mutex> lock(dependency.job->dependentsMutex);
+        if (dependency.job->isDone.load(std::memory_order_acquire))
+            continue;
+        job->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+        dependency.job->dependents.push_back(job);
+    }
+
+    if (job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        Enqueue(job);
+
+    return JobHandle(job);
+}
+
+void JobSystem::Enqueue(const std::shared_ptr<JobHandle::Job>& job)
+{
+    if (job->isMainThreadOnly)
+    {
+        std::lock_guard<std::mutex> lock(mainThreadMutex);
+        (job->isFrameStage ? frameStageJobs : mainThreadJobs).push_back(job);
+        return;
+    }
+
+    //without workers there is nobody to hand the job to
+    if (!isRunning)
+    {
+        Execute(job);
+        return;
+    }
+
+    WorkQueue& queue = *queues[GetCurrentQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+    queuedJobCount.fetch_add(1, std::memory_order_release);
+
+    //taking the lock orders this notify after a worker's predicate check, so the wakeup cannot be lost
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    jobAvailable.notify_one();
+}
+
+std::shared_ptr<JobHandle::Job> JobSystem::TryTakeJob(size_t queueIndex)
+{
+    if (queuedJobCount.load(std::memory_order_acquire) == 0)
+        return nullptr;
+
+    {
+        WorkQueue& own = *queues[queueIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty())
+        {
+            std::shared_ptr<JobHandle::Job> job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            queuedJobCount.fetch_sub(1, std::memory_order_acq_rel);
+            return job;
+        }
+    }
+
+    for (size_t i = 1; i < queues.size(); ++i)
+    {
+        WorkQueue& victim = *queues[(queueIndex + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty())
+        {
+            std::shared_ptr<JobHandle::Job> job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            queuedJobCount.fetch_sub(1, std::memory_order_acq_rel);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::Execute(const std::shared_ptr<JobHandle::Job>& job)
+{
+    if (job->function)
+        job->function();
+    job->function = nullptr;
+
+    std::vector<std::shared_ptr<JobHandle::Job>> dependents;
+    {
+        std::lock_guard<std::mutex> lock(job->dependentsMutex);
+        job->isDone.store(true, std::memory_order_release);
+        std::swap(dependents, job->dependents);
+    }
+
+    for (const auto& dependent : dependents)
+        if (dependent->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Enqueue(dependent);
+}
+
+bool JobSystem::TryExecuteMainThreadJob()
+{
+    std::shared_ptr<JobHandle::Job> job;
+    {
+        std::lock_guard<std::mutex> lock(mainThreadMutex);
+        if (mainThreadJobs.empty())
+            return false;
+        job = std::move(mainThreadJobs.front());
+        mainThreadJobs.erase(mainThreadJobs.begin());
+    }
+    Execute(job);
+    return true;
+}
+
+bool JobSystem::TryExecuteFrameStageJob()
+{
+    std::shared_ptr<JobHandle::Job> job;
+    {
+        std::lock_guard<std::mutex> lock(mainThreadMutex);
+        if (frameStageJobs.empty())
+            return false;
+        job = std::move(frameStageJobs.front());
+        frameStageJobs.erase(frameStageJobs.begin());
+    }
+    Execute(job);
+    return true;
+}
+
+void JobSystem::ExecuteMainThreadJobs()
+{
+    //continuations queued by these jobs run next frame so a self-rescheduling job cannot stall the loop
+    std::vector<std::shared_ptr<JobHandle::Job>> jobs;
+    {
+        std::lock_guard<std::mutex> lock(mainThreadMutex);
+        std::swap(jobs, mainThreadJobs);
+    }
+    for (const auto& job : jobs)
+        Execute(job);
+}
+
+void JobSystem::Wait(const JobHandle& handle)
+{
+    const bool isMainThread = IsMainThread();
+    while (!handle.IsDone())
+    {
+        if (isMainThread && TryExecuteMainThreadJob())
+            continue;
+
+        if (isRunning)
+        {
+            if (std::shared_ptr<JobHandle::Job> job = TryTakeJob(GetCurrentQueueIndex()))
+            {
+                Execute(job);
+                continue;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+void JobSystem::WaitForFrameStage(const JobHandle& handle)
+{
+    //worker stages may still be reading objects here, so game continuations wait for ExecuteMainThreadJobs
+    const bool isMainThread = IsMainThread();
+    while (!handle.IsDone())
+    {
+        if (isMainThread && TryExecuteFrameStageJob())
+            continue;
+
+        if (isRunning)
+        {
+            if (std::shared_ptr<JobHandle::Job> job = TryTakeJob(GetCurrentQueueIndex()))
+            {
+                Execute(job);
+                continue;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+void JobSystem::WaitForWorkerJobs(const JobHandle& handle)
+{
+    while (!handle.IsDone())
+    {
+        if (isRunning)
+        {
+            if (std::shared_ptr<JobHandle::Job> job = TryTakeJob(GetCurrentQueueIndex()))
+            {
+                Execute(job);
+                continue;
+            }
+        }
+        std::this_thread::yield();
+    }
+}
+
+JobHandle JobSystem::ScheduleParallelFor(size_t count, size_t grainSize, JobRangeFunction body, const std::vector<JobHandle>& dependencies)
+{
+    if (count == 0)
+        return Submit(nullptr, dependencies, false);
+
+    size_t maxChunks = (workers.size() + 1) * CHUNKS_PER_THREAD;
+    grainSize = std::max({ grainSize, static_cast<size_t>(1), (count + maxChunks - 1) / maxChunks });
+
+    auto sharedBody = std::make_shared<JobRangeFunction>(std::move(body));
+    std::vector<JobHandle> chunks;
+    chunks.reserve((count + grainSize - 1) / grainSize);
+    for (size_t begin = 0; begin < count; begin += grainSize)
+    {
+        size_t end = std::min(begin + grainSize, count);
+        chunks.push_back(Submit([sharedBody, begin, end]() { (*sharedBody)(begin, end); }, dependencies, false));
+    }
+
+    if (chunks.size() == 1)
+        return chunks.front();
+    return Submit(nullptr, chunks, false);
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grainSize, const JobRangeFunction& body)
+{
+    grainSize = std::max<size_t>(grainSize, 1);
+    if (count == 0)
+        return;
+    if (!isRunning || count <= grainSize)
+    {
+        body(0, count);
+        return;
+    }
+
+    size_t maxChunks = (workers.size() + 1) * CHUNKS_PER_THREAD;
+    grainSize = std::max(grainSize, (count + maxChunks - 1) / maxChunks);
+    const size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+    //helpers and the caller pull chunks from a shared counter, so a late helper simply finds nothing left
+    std::atomic<size_t> nextChunk = 0;
+    auto runChunks = [&]()
+        {
+            for (size_t chunk = nextChunk.fetch_add(1); chunk < chunkCount; chunk = nextChunk.fetch_add(1))
+            {
+                size_t begin = chunk * grainSize;
+                body(begin, std::min(begin + grainSize, count));
+            }
+        };
+
+    size_t helperCount = std::min(workers.size(), chunkCount - 1);
+    std::vector<JobHandle> helpers;
+    helpers.reserve(helperCount);
+    for (size_t i = 0; i < helperCount; ++i)
+        helpers.push_back(Schedule(runChunks));
+
+    runChunks();
+
+    for (const JobHandle& helper : helpers)
+        WaitForWorkerJobs(helper);
+}
+
+void JobSystem::WorkerLoop(size_t queueIndex)
+{
+    currentQueueIndex = queueIndex;
+
+    while (isRunning)
+    {
+        if (std::shared_ptr<JobHandle::Job> job = TryTakeJob(queueIndex))
+        {
+            Execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        jobAvailable.wait(lock, [this]() { return !isRunning || queuedJobCount.load(std::memory_order_acquire) > 0; });
+    }
+}
+
+size_t JobSystem::GetCurrentQueueIndex() const
+{
+    //threads the system does not own share the main thread's queue
+    return currentQueueIndex == INVALID_QUEUE ? 0 : currentQueueIndex;
+}
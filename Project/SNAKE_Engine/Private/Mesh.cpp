@@ -16,13 +16,41 @@ GLenum ToGL(PrimitiveType type)
     return GL_TRIANGLES;
 }
 
-Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, PrimitiveType primitiveType_) :vao(0), vbo(0), ebo(0), instanceVAO(0), indexCount(0), useIndex(false), primitiveType(primitiveType_)
+Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, PrimitiveType primitiveType_, const VertexLayout& layout_) :vao(0), vbo(0), ebo(0), instanceVAO(0), indexCount(0), useIndex(false), layout(layout_), primitiveType(primitiveType_)
 {
     instanceVBO[0] = instanceVBO[1] = instanceVBO[2] = instanceVBO[3] = 0;
     SetupMesh(vertices, indices);
     ComputeLocalBounds(vertices);
 }
 
+Mesh::Mesh(PrimitiveType primitiveType_, const VertexLayout& layout_) :vao(0), vbo(0), ebo(0), instanceVAO(0), indexCount(0), useIndex(false), layout(layout_), primitiveType(primitiveType_)
+{
+    instanceVBO[0] = instanceVBO[1] = instanceVBO[2] = instanceVBO[3] = 0;
+    localHalfSize = glm::vec2(0.5f);
+}
+
+Mesh::Mesh(MeshArena& arena_, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, PrimitiveType primitiveType_) :vao(0), vbo(0), ebo(0), instanceVAO(0), indexCount(0), useIndex(false), layout(arena_.GetLayout()), primitiveType(primitiveType_)
+{
+    instanceVBO[0] = instanceVBO[1] = instanceVBO[2] = instanceVBO[3] = 0;
+
+    MeshArenaRange range;
+    if (arena_.Allocate(vertices, indices, range))
+    {
+        arena = &arena_;
+        baseVertex = range.baseVertex;
+        vertexCount = range.vertexCount;
+        indexByteOffset = range.firstIndexSlot * sizeof(uint32_t);
+        useIndex = range.indexCount > 0;
+        useShortIndex = range.useShortIndex;
+        indexCount = useIndex ? range.indexCount : range.vertexCount;
+    }
+    else
+    {
+        SetupMesh(vertices, indices);
+    }
+    ComputeLocalBounds(vertices);
+}
+
 void Mesh::Draw() const
 {
     BindVAO(false);
@@ -30,11 +58,12 @@ void Mesh::Draw() const
 
     if (useIndex)
     {
-        glDrawElements(mode, indexCount, GL_UNSIGNED_INT, 0);
+        const void* offset = reinterpret_cast<const void*>(static_cast<uintptr_t>(indexByteOffset));
+        glDrawElementsBaseVertex(mode, indexCount, useShortIndex ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, offset, baseVertex);
     }
     else
     {
-        glDrawArrays(mode, 0, indexCount);
+        glDrawArrays(mode, baseVertex, indexCount);
     }
 }
 
@@ -44,18 +73,37 @@ void Mesh::DrawInstanced(GLsizei instanceCount) const
     GLenum mode = ToGL(primitiveType);
 
     if (useIndex)
-        glDrawElementsInstanced(mode, indexCount, GL_UNSIGNED_INT, nullptr, instanceCount);
+    {
+        const void* offset = reinterpret_cast<const void*>(static_cast<uintptr_t>(indexByteOffset));
+        glDrawElementsInstancedBaseVertex(mode, indexCount, useShortIndex ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, offset, instanceCount, baseVertex);
+    }
     else
-        glDrawArraysInstanced(mode, 0, indexCount, instanceCount);
+        glDrawArraysInstanced(mode, baseVertex, indexCount, instanceCount);
 }
 
 void Mesh::BindVAO(bool instanced) const
 {
-    instanced ? glBindVertexArray(instanceVAO) : glBindVertexArray(vao);
+    if (arena)
+        instanced ? glBindVertexArray(arena->instanceVAO) : glBindVertexArray(arena->vao);
+    else
+        instanced ? glBindVertexArray(instanceVAO) : glBindVertexArray(vao);
 }
 
 Mesh::~Mesh()
 {
+    if (arena)
+    {
+        MeshArenaRange range;
+        range.baseVertex = baseVertex;
+        range.vertexCount = vertexCount;
+        range.firstIndexSlot = indexByteOffset / sizeof(uint32_t);
+        if (useIndex)
+        {
+            const size_t indexBytes = static_cast<size_t>(indexCount) * (useShortIndex ? sizeof(uint16_t) : sizeof(uint32_t));
+            range.indexSlotCount = static_cast<GLsizei>((indexBytes + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+        }
+        arena->Free(range);
+    }
     glDeleteBuffers(1, &ebo);
     glDeleteBuffers(1, &vbo);
     glDeleteVertexArrays(1, &vao);
@@ -68,20 +116,16 @@ Mesh::~Mesh()
 
 void Mesh::SetupInstanceAttributes() 
 {
+    //the arena's instanced VAO is configured once for every mesh it holds
+    if (arena)
+        return;
+
     if (!instanceVAO)
         glCreateVertexArrays(1, &instanceVAO);
 
-    glVertexArrayVertexBuffer(instanceVAO, 0, vbo, 0, sizeof(Vertex));
+    layout.SetupAttributes(instanceVAO, vbo);
 
-    glEnableVertexArrayAttrib(instanceVAO, 0);
-    glVertexArrayAttribFormat(instanceVAO, 0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, position));
-    glVertexArrayAttribBinding(instanceVAO, 0, 0);
-
-    glEnableVertexArrayAttrib(instanceVAO, 1);
-    glVertexArrayAttribFormat(instanceVAO, 1, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, uv));
-    glVertexArrayAttribBinding(instanceVAO, 1, 0);
-
-    if (useIndex && ebo)
+    if (ebo)
         glVertexArrayElementBuffer(instanceVAO, ebo);
 
     if (!instanceVBO[0])
@@ -129,32 +173,34 @@ void Mesh::SetupMesh(const std::vector<Vertex>& vertices, const std::vector<unsi
     // Create VAO
     glCreateVertexArrays(1, &vao);
 
-    // Create and bind VBO
+    // Create VBO, packed to the declared layout
+    std::vector<unsigned char> vertexData;
+    layout.PackVertices(vertices, vertexData);
     glCreateBuffers(1, &vbo);
-    glNamedBufferData(vbo, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    glNamedBufferData(vbo, vertexData.size(), vertexData.data(), GL_STATIC_DRAW);
 
     // Bind VBO to VAO
-    glVertexArrayVertexBuffer(vao, 0, vbo, 0,  sizeof(Vertex));
-
-    glEnableVertexArrayAttrib(vao, 0); // position
-    glVertexArrayAttribFormat(vao, 0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, position));
-    glVertexArrayAttribBinding(vao, 0, 0);
-
-    glEnableVertexArrayAttrib(vao, 1); // uv
-    glVertexArrayAttribFormat(vao, 1, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, uv));
-    glVertexArrayAttribBinding(vao, 1, 0);
+    layout.SetupAttributes(vao, vbo);
 
-    // EBO (Element Buffer)
+    // EBO (Element Buffer), narrowed to 16-bit indices when the vertex count allows
     if (useIndex)
     {
+        std::vector<unsigned char> indexData;
+        useShortIndex = VertexLayout::PackIndices(indices, vertices.size(), indexData);
         glCreateBuffers(1, &ebo);
-        glNamedBufferData(ebo, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        glNamedBufferData(ebo, indexData.size(), indexData.data(), GL_STATIC_DRAW);
         glVertexArrayElementBuffer(vao, ebo);
     }
 }
 
 void Mesh::UpdateInstanceBuffer(const std::vector<glm::mat4>& transforms, const std::vector<glm::vec4>& colors, const std::vector<glm::vec2>& uvOffsets, const std::vector<glm::vec2>& uvScales) const
 {
+    if (arena)
+    {
+        arena->UpdateInstanceBuffer(transforms, colors, uvOffsets, uvScales);
+        return;
+    }
+
     BindVAO(true);
     glBindBuffer(GL_ARRAY_BUFFER, instanceVBO[0]);
     glBufferData(GL_ARRAY_BUFFER, transforms.size() * sizeof(glm::mat4), transforms.data(), GL_DYNAMIC_DRAW);
@@ -0,0 +1,225 @@
+#include "Engine.h"
+
+#include <algorithm>
+
+#include "gl.h"
+
+static bool TakeFirstFit(std::vector<MeshArenaBlock>& freeBlocks, GLsizei count, GLsizei& outOffset)
+{
+    for (auto it = freeBlocks.begin(); it != freeBlocks.end(); ++it)
+    {
+        if (it->count < count)
+            continue;
+
+        outOffset = it->offset;
+        it->offset += count;
+        it->count -= count;
+        if (it->count == 0)
+            freeBlocks.erase(it);
+        return true;
+    }
+    return false;
+}
+
+static void ReturnBlock(std::vector<MeshArenaBlock>& freeBlocks, GLsizei offset, GLsizei count)
+{
+    if (count <= 0)
+        return;
+
+    //free list stays sorted by offset so neighbours can be merged back into one block
+    auto it = std::lower_bound(freeBlocks.begin(), freeBlocks.end(), offset,
+        [](const MeshArenaBlock& block, GLsizei value) { return block.offset < value; });
+    it = freeBlocks.insert(it, { offset, count });
+
+    auto next = it + 1;
+    if (next != freeBlocks.end() && it->offset + it->count == next->offset)
+    {
+        it->count += next->count;
+        freeBlocks.erase(next);
+    }
+    if (it != freeBlocks.begin())
+    {
+        auto prev = it - 1;
+        if (prev->offset + prev->count == it->offset)
+        {
+            prev->count += it->count;
+            freeBlocks.erase(it);
+        }
+    }
+}
+
+static void GrowBuffer(GLuint& buffer, GLsizei& capacity, GLsizeiptr stride, std::vector<MeshArenaBlock>& freeBlocks, GLsizei minFreeCount)
+{
+    GLsizei tailFree = 0;
+    if (!freeBlocks.empty() && freeBlocks.back().offset + freeBlocks.back().count == capacity)
+        tailFree = freeBlocks.back().count;
+
+    GLsizei newCapacity = std::max<GLsizei>(capacity, 1);
+    while (newCapacity - capacity + tailFree < minFreeCount)
+        newCapacity *= 2;
+
+    GLuint newBuffer = 0;
+    glCreateBuffers(1, &newBuffer);
+    glNamedBufferStorage(newBuffer, newCapacity * stride, nullptr, GL_DYNAMIC_STORAGE_BIT);
+    if (buffer)
+    {
+        glCopyNamedBufferSubData(buffer, newBuffer, 0, 0, capacity * stride);
+        glDeleteBuffers(1, &buffer);
+    }
+
+    ReturnBlock(freeBlocks, capacity, newCapacity - capacity);
+    buffer = newBuffer;
+    capacity = newCapacity;
+}
+
+MeshArena::~MeshArena()
+{
+    Shutdown();
+}
+
+void MeshArena::Init(GLsizei initialVertexCapacity, GLsizei initialIndexSlotCapacity)
+{
+    if (vao)
+        return;
+
+    GrowBuffer(vbo, vertexCapacity, layout.GetStride(), freeVertices, initialVertexCapacity);
+    GrowBuffer(ebo, indexCapacity, sizeof(uint32_t), freeIndices, initialIndexSlotCapacity);
+
+    glCreateVertexArrays(1, &vao);
+    glCreateVertexArrays(1, &instanceVAO);
+    glCreateBuffers(4, instanceVBO);
+    SetupVertexArrays();
+}
+
+void MeshArena::Shutdown()
+{
+    glDeleteBuffers(4, instanceVBO);
+    glDeleteBuffers(1, &ebo);
+    glDeleteBuffers(1, &vbo);
+    glDeleteVertexArrays(1, &instanceVAO);
+    glDeleteVertexArrays(1, &vao);
+    instanceVAO = vao = 0;
+    ebo = vbo = 0;
+    instanceVBO[0] = instanceVBO[1] = instanceVBO[2] = instanceVBO[3] = 0;
+
+    vertexCapacity = indexCapacity = 0;
+    freeVertices.clear();
+    freeIndices.clear();
+}
+
+bool MeshArena::Allocate(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, MeshArenaRange& out)
+{
+    if (!vao || vertices.empty())
+        return false;
+
+    std::vector<unsigned char> vertexData;
+    std::vector<unsigned char> indexData;
+    layout.PackVertices(vertices, vertexData);
+    const bool useShortIndex = VertexLayout::PackIndices(indices, vertices.size(), indexData);
+
+    const GLsizei stride = layout.GetStride();
+    const GLsizei vertexCount = static_cast<GLsizei>(vertices.size());
+    const GLsizei indexSlotCount = static_cast<GLsizei>((indexData.size() + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+
+    GLsizei vertexOffset = 0;
+    if (!TakeFirstFit(freeVertices, vertexCount, vertexOffset))
+    {
+        GrowVertexBuffer(vertexCount);
+        if (!TakeFirstFit(freeVertices, vertexCount, vertexOffset))
+            return false;
+    }
+
+    GLsizei indexSlotOffset = 0;
+    if (indexSlotCount > 0 && !TakeFirstFit(freeIndices, indexSlotCount, indexSlotOffset))
+    {
+        GrowIndexBuffer(indexSlotCount);
+        if (!TakeFirstFit(freeIndices, indexSlotCount, indexSlotOffset))
+        {
+            ReturnBlock(freeVertices, vertexOffset, vertexCount);
+            return false;
+        }
+    }
+
+    glNamedBufferSubData(vbo, static_cast<GLintptr>(vertexOffset) * stride, vertexData.size(), vertexData.data());
+    if (indexSlotCount > 0)
+        glNamedBufferSubData(ebo, static_cast<GLintptr>(indexSlotOffset) * sizeof(uint32_t), indexData.size(), indexData.data());
+
+    out.baseVertex = vertexOffset;
+    out.vertexCount = vertexCount;
+    out.firstIndexSlot = static_cast<GLuint>(indexSlotOffset);
+    out.indexSlotCount = indexSlotCount;
+    out.indexCount = static_cast<GLsizei>(indices.size());
+    out.useShortIndex = useShortIndex;
+    return true;
+}
+
+void MeshArena::Free(const MeshArenaRange& range)
+{
+    if (!vao)
+        return;
+    ReturnBlock(freeVertices, range.baseVertex, range.vertexCount);
+    ReturnBlock(freeIndices, static_cast<GLsizei>(range.firstIndexSlot), range.indexSlotCount);
+}
+
+void MeshArena::GrowVertexBuffer(GLsizei minFreeCount)
+{
+    GrowBuffer(vbo, vertexCapacity, layout.GetStride(), freeVertices, minFreeCount);
+    SetupVertexArrays();
+}
+
+void MeshArena::GrowIndexBuffer(GLsizei minFreeCount)
+{
+    GrowBuffer(ebo, indexCapacity, sizeof(uint32_t), freeIndices, minFreeCount);
+    SetupVertexArrays();
+}
+
+void MeshArena::SetupVertexArrays()
+{
+    //both VAOs read the same vertex/index storage; only the instanced one has per-instance streams
+    for (GLuint array : { vao, instanceVAO })
+    {
+        layout.SetupAttributes(array, vbo);
+        glVertexArrayElementBuffer(array, ebo);
+    }
+
+    GLuint loc;
+    glVertexArrayVertexBuffer(instanceVAO, 1, instanceVBO[0], 0, sizeof(glm::mat4));
+    for (int i = 0; i < 4; i++)
+    {
+        loc = 2 + i;
+        glEnableVertexArrayAttrib(instanceVAO, loc);
+        glVertexArrayAttribFormat(instanceVAO, loc, 4, GL_FLOAT, GL_FALSE, sizeof(glm::vec4) * i);
+        glVertexArrayAttribBinding(instanceVAO, loc, 1);
+    }
+    glVertexArrayBindingDivisor(instanceVAO, 1, 1);
+
+    loc = 6;
+    glVertexArrayVertexBuffer(instanceVAO, 2, instanceVBO[1], 0, sizeof(glm::vec4));
+    glEnableVertexArrayAttrib(instanceVAO, loc);
+    glVertexArrayAttribFormat(instanceVAO, loc, 4, GL_FLOAT, GL_FALSE, 0);
+    glVertexArrayAttribBinding(instanceVAO, loc, 2);
+    glVertexArrayBindingDivisor(instanceVAO, 2, 1);
+
+    loc = 7;
+    glVertexArrayVertexBuffer(instanceVAO, 3, instanceVBO[2], 0, sizeof(glm::vec2));
+    glEnableVertexArrayAttrib(instanceVAO, loc);
+    glVertexArrayAttribFormat(instanceVAO, loc, 2, GL_FLOAT, GL_FALSE, 0);
+    glVertexArrayAttribBinding(instanceVAO, loc, 3);
+    glVertexArrayBindingDivisor(instanceVAO, 3, 1);
+
+    loc = 8;
+    glVertexArrayVertexBuffer(instanceVAO, 4, instanceVBO[3], 0, sizeof(glm::vec2));
+    glEnableVertexArrayAttrib(instanceVAO, loc);
+    glVertexArrayAttribFormat(instanceVAO, loc, 2, GL_FLOAT, GL_FALSE, 0);
+    glVertexArrayAttribBinding(instanceVAO, loc, 4);
+    glVertexArrayBindingDivisor(instanceVAO, 4, 1);
+}
+
+void MeshArena::UpdateInstanceBuffer(const std::vector<glm::mat4>& transforms, const std::vector<glm::vec4>& colors, const std::vector<glm::vec2>& uvOffsets, const std::vector<glm::vec2>& uvScales) const
+{
+    //instance streams are re-specified per batch, so one shared set serves every mesh in the arena
+    glNamedBufferData(instanceVBO[0], transforms.size() * sizeof(glm::mat4), transforms.data(), GL_DYNAMIC_DRAW);
+    glNamedBufferData(instanceVBO[1], colors.size() * sizeof(glm::vec4), colors.data(), GL_DYNAMIC_DRAW);
+    glNamedBufferData(instanceVBO[2], uvOffsets.size() * sizeof(glm::vec2), uvOffsets.data(), GL_DYNAMIC_DRAW);
+    glNamedBufferData(instanceVBO[3], uvScales.size() * sizeof(glm::vec2), uvScales.data(), GL_DYNAMIC_DRAW);
+}
@@ -0,0 +1,250 @@
+#include "Engine.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SNAKE_NARROW_PHASE_AVX2 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+//msvc accepts AVX intrinsics without /arch, the CPU check below keeps them off older machines
+#define SNAKE_TARGET_AVX2
+#else
+#include <immintrin.h>
+#define SNAKE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace
+{
+    struct PairColumns
+    {
+        Object* const* objectA;
+        Object* const* objectB;
+        const float* centerAX;
+        const float* centerAY;
+        const float* extentAX;
+        const float* extentAY;
+        const float* centerBX;
+        const float* centerBY;
+        const float* extentBX;
+        const float* extentBY;
+        size_t count;
+    };
+
+    bool TestCircleCircle(const PairColumns& c, size_t i)
+    {
+        const float dx = c.centerAX[i] - c.centerBX[i];
+        const float dy = c.centerAY[i] - c.centerBY[i];
+        const float radiusSum = c.extentAX[i] + c.extentBX[i];
+        return dx * dx + dy * dy <= radiusSum * radiusSum;
+    }
+
+    bool TestAABBAABB(const PairColumns& c, size_t i)
+    {
+        return std::abs(c.centerAX[i] - c.centerBX[i]) <= c.extentAX[i] + c.extentBX[i] &&
+            std::abs(c.centerAY[i] - c.centerBY[i]) <= c.extentAY[i] + c.extentBY[i];
+    }
+
+    bool TestCircleAABB(const PairColumns& c, size_t i)
+    {
+        const float closestX = std::min(std::max(c.centerAX[i], c.centerBX[i] - c.extentBX[i]), c.centerBX[i] + c.extentBX[i]);
+        const float closestY = std::min(std::max(c.centerAY[i], c.centerBY[i] - c.extentBY[i]), c.centerBY[i] + c.extentBY[i]);
+        const float dx = c.centerAX[i] - closestX;
+        const float dy = c.centerAY[i] - closestY;
+        return dx * dx + dy * dy <= c.extentAX[i] * c.extentAX[i];
+    }
+
+    template<bool (*Test)(const PairColumns&, size_t)>
+    void RunScalar(const PairColumns& c, size_t begin, std::vector<BroadPhasePair>& outContacts)
+    {
+        for (size_t i = begin; i < c.count; ++i)
+        {
+            if (Test(c, i))
+                outContacts.emplace_back(c.objectA[i], c.objectB[i]);
+        }
+    }
+
+#if SNAKE_NARROW_PHASE_AVX2
+    bool HasAVX2()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+
+        //the OS must also save the ymm registers on context switches
+        __cpuid(info, 1);
+        const bool hasOSXSave = (info[2] & (1 << 27)) != 0;
+        const bool hasAVX = (info[2] & (1 << 28)) != 0;
+        if (!hasOSXSave || !hasAVX || (_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    struct PairLanes
+    {
+        __m256 centerAX;
+        __m256 centerAY;
+        __m256 extentAX;
+        __m256 extentAY;
+        __m256 centerBX;
+        __m256 centerBY;
+        __m256 extentBX;
+        __m256 extentBY;
+    };
+
+    SNAKE_TARGET_AVX2 inline __m256 TestCircleCircle8(const PairLanes& l)
+    {
+        const __m256 dx = _mm256_sub_ps(l.centerAX, l.centerBX);
+        const __m256 dy = _mm256_sub_ps(l.centerAY, l.centerBY);
+        const __m256 radiusSum = _mm256_add_ps(l.extentAX, l.extentBX);
+        const __m256 distSqr = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        return _mm256_cmp_ps(distSqr, _mm256_mul_ps(radiusSum, radiusSum), _CMP_LE_OQ);
+    }
+
+    SNAKE_TARGET_AVX2 inline __m256 TestAABBAABB8(const PairLanes& l)
+    {
+        const __m256 signBit = _mm256_set1_ps(-0.f);
+        const __m256 distX = _mm256_andnot_ps(signBit, _mm256_sub_ps(l.centerAX, l.centerBX));
+        const __m256 distY = _mm256_andnot_ps(signBit, _mm256_sub_ps(l.centerAY, l.centerBY));
+        return _mm256_and_ps(
+            _mm256_cmp_ps(distX, _mm256_add_ps(l.extentAX, l.extentBX), _CMP_LE_OQ),
+            _mm256_cmp_ps(distY, _mm256_add_ps(l.extentAY, l.extentBY), _CMP_LE_OQ));
+    }
+
+    SNAKE_TARGET_AVX2 inline __m256 TestCircleAABB8(const PairLanes& l)
+    {
+        const __m256 closestX = _mm256_min_ps(_mm256_max_ps(l.centerAX, _mm256_sub_ps(l.centerBX, l.extentBX)), _mm256_add_ps(l.centerBX, l.extentBX));
+        const __m256 closestY = _mm256_min_ps(_mm256_max_ps(l.centerAY, _mm256_sub_ps(l.centerBY, l.extentBY)), _mm256_add_ps(l.centerBY, l.extentBY));
+        const __m256 dx = _mm256_sub_ps(l.centerAX, closestX);
+        const __m256 dy = _mm256_sub_ps(l.centerAY, closestY);
+        const __m256 distSqr = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        return _mm256_cmp_ps(distSqr, _mm256_mul_ps(l.extentAX, l.extentAX), _CMP_LE_OQ);
+    }
+
+    //returns how many pairs it covered; the remainder goes through RunScalar
+    template<__m256 (*Test)(const PairLanes&)>
+    SNAKE_TARGET_AVX2 size_t RunAVX2(const PairColumns& c, std::vector<BroadPhasePair>& outContacts)
+    {
+        size_t i = 0;
+        for (; i + 8 <= c.count; i += 8)
+        {
+            const PairLanes lanes{
+                _mm256_loadu_ps(c.centerAX + i), _mm256_loadu_ps(c.centerAY + i),
+                _mm256_loadu_ps(c.extentAX + i), _mm256_loadu_ps(c.extentAY + i),
+                _mm256_loadu_ps(c.centerBX + i), _mm256_loadu_ps(c.centerBY + i),
+                _mm256_loadu_ps(c.extentBX + i), _mm256_loadu_ps(c.extentBY + i) };
+
+            unsigned int mask = static_cast<unsigned int>(_mm256_movemask_ps(Test(lanes)));
+            while (mask)
+            {
+                const size_t lane = i + std::countr_zero(mask);
+                outContacts.emplace_back(c.objectA[lane], c.objectB[lane]);
+                mask &= mask - 1;
+            }
+        }
+        return i;
+    }
+
+    const bool isAVX2Supported = HasAVX2();
+#endif
+}
+
+void NarrowPhase::PairBucket::Clear()
+{
+    objectA.clear();
+    objectB.clear();
+    centerAX.clear();
+    centerAY.clear();
+    extentAX.clear();
+    extentAY.clear();
+    centerBX.clear();
+    centerBY.clear();
+    extentBX.clear();
+    extentBY.clear();
+}
+
+void NarrowPhase::PairBucket::Push(Object* a, const ColliderShape& shapeA, Object* b, const ColliderShape& shapeB)
+{
+    objectA.push_back(a);
+    objectB.push_back(b);
+    centerAX.push_back(shapeA.center.x);
+    centerAY.push_back(shapeA.center.y);
+    extentAX.push_back(shapeA.extent.x);
+    extentAY.push_back(shapeA.extent.y);
+    centerBX.push_back(shapeB.center.x);
+    centerBY.push_back(shapeB.center.y);
+    extentBX.push_back(shapeB.extent.x);
+    extentBY.push_back(shapeB.extent.y);
+}
+
+void NarrowPhase::Clear()
+{
+    for (PairBucket& bucket : buckets)
+        bucket.Clear();
+}
+
+void NarrowPhase::Add(Object* a, const ColliderShape& shapeA, Object* b, const ColliderShape& shapeB)
+{
+    const bool isCircleA = shapeA.type == ColliderType::Circle;
+    const bool isCircleB = shapeB.type == ColliderType::Circle;
+
+    if (isCircleA && isCircleB)
+        buckets[CIRCLE_CIRCLE].Push(a, shapeA, b, shapeB);
+    else if (!isCircleA && !isCircleB)
+        buckets[AABB_AABB].Push(a, shapeA, b, shapeB);
+    else if (isCircleA)
+        buckets[CIRCLE_AABB].Push(a, shapeA, b, shapeB);
+    else
+        buckets[CIRCLE_AABB].Push(b, shapeB, a, shapeA);
+}
+
+void NarrowPhase::Run(std::vector<BroadPhasePair>& outContacts) const
+{
+    for (int kind = 0; kind < BUCKET_COUNT; ++kind)
+    {
+        const PairBucket& bucket = buckets[kind];
+        const PairColumns columns{
+            bucket.objectA.data(), bucket.objectB.data(),
+            bucket.centerAX.data(), bucket.centerAY.data(), bucket.extentAX.data(), bucket.extentAY.data(),
+            bucket.centerBX.data(), bucket.centerBY.data(), bucket.extentBX.data(), bucket.extentBY.data(),
+            bucket.objectA.size() };
+
+        size_t done = 0;
+        switch (kind)
+        {
+        case CIRCLE_CIRCLE:
+#if SNAKE_NARROW_PHASE_AVX2
+            if (isAVX2Supported)
+                done = RunAVX2<TestCircleCircle8>(columns, outContacts);
+#endif
+            RunScalar<TestCircleCircle>(columns, done, outContacts);
+            break;
+        case AABB_AABB:
+#if SNAKE_NARROW_PHASE_AVX2
+            if (isAVX2Supported)
+                done = RunAVX2<TestAABBAABB8>(columns, outContacts);
+#endif
+            RunScalar<TestAABBAABB>(columns, done, outContacts);
+            break;
+        case CIRCLE_AABB:
+#if SNAKE_NARROW_PHASE_AVX2
+            if (isAVX2Supported)
+                done = RunAVX2<TestCircleAABB8>(columns, outContacts);
+#endif
+            RunScalar<TestCircleAABB>(columns, done, outContacts);
+            break;
+        default:
+            break;
+        }
+    }
+}
@@ -1,5 +1,7 @@
 #include "Engine.h"
 
+#include <algorithm>
+
 const bool& Object::IsAlive() const
 {
     return isAlive;
@@ -13,16 +15,74 @@ const bool& Object::IsVisible() const
 void Object::SetVisibility(bool _isVisible)
 {
     isVisible = _isVisible;
+    if (ComponentRow& row = transform2D.row; row.store)
+        row.store->flags[row.index] = ObjectComponentStore::MakeFlags(*this);
 }
 
 void Object::Kill()
 {
     isAlive = false;
+    if (ComponentRow& row = transform2D.row; row.store)
+        row.store->flags[row.index] &= ~ObjectComponentStore::ROW_ALIVE;
+}
+
+void Object::SetUpdatePolicy(UpdatePolicy policy, uint32_t frameInterval)
+{
+    //the manager finds the current bucket through the old policy
+    if (ownerManager)
+        ownerManager->RemoveFromUpdateTier(this);
+    updatePolicy = policy;
+    updateInterval = policy == UpdatePolicy::Interval ? std::max(frameInterval, 1u) : 1u;
+    WriteUpdateFlags();
+    if (ownerManager)
+        ownerManager->RefreshUpdateTier(this);
+}
+
+void Object::Sleep(float wakeAfterSeconds)
+{
+    isAsleep = true;
+    ++sleepGeneration;
+    WriteUpdateFlags();
+    if (ownerManager)
+    {
+        ownerManager->RefreshUpdateTier(this);
+        if (wakeAfterSeconds > 0.f)
+            ownerManager->ScheduleWakeUp(this, wakeAfterSeconds);
+    }
+}
+
+void Object::WakeUp()
+{
+    if (!isAsleep)
+        return;
+    isAsleep = false;
+    ++sleepGeneration;
+    WriteUpdateFlags();
+    if (ownerManager)
+        ownerManager->RefreshUpdateTier(this);
+}
+
+void Object::WriteUpdateFlags()
+{
+    ComponentRow& row = transform2D.row;
+    if (!row.store)
+        return;
+
+    uint8_t& flags = row.store->flags[row.index];
+    flags &= ~(ObjectComponentStore::ROW_ASLEEP | ObjectComponentStore::ROW_TIERED_UPDATE);
+    flags |= ObjectComponentStore::MakeUpdateFlags(*this);
 }
 
 void Object::SetTag(const std::string& tag)
 {
+    //once registered, the manager's tag index must move with the tag or it keeps the object under the old one
+    if (ownerManager && ownerManager->IsRegistered(this))
+    {
+        ownerManager->Retag(this, tag);
+        return;
+    }
     objectTag = tag;
+    objectTagID = tag.empty() ? StringID() : StringID(tag);
 }
 
 const std::string& Object::GetTag() const
@@ -38,11 +98,27 @@ const std::string& Object::GetRenderLayerTag() const
 void Object::SetRenderLayer(const std::string& tag)
 {
     renderLayerTag = tag;
+    renderLayerTagID = StringID(tag);
+    //the layer id is looked up again by the next submit
+    if (ComponentRow& row = transform2D.row; row.store)
+        row.store->renderLayers[row.index] = ObjectComponentStore::UNRESOLVED_LAYER;
 }
 
 void Object::SetMaterial(const EngineContext& engineContext, const std::string& tag)
 {
-    material = engineContext.renderManager->GetMaterialByTag(tag);
+    SetMaterial(engineContext.renderManager->GetMaterialByTag(tag));
+}
+
+void Object::SetMaterial(const EngineContext& engineContext, StringID tag)
+{
+    SetMaterial(engineContext.renderManager->GetMaterialByTag(tag));
+}
+
+void Object::SetMaterial(Material* material_)
+{
+    material = material_;
+    if (ComponentRow& row = transform2D.row; row.store)
+        row.store->materials[row.index] = material;
 }
 
 
@@ -53,7 +129,19 @@ Material* Object::GetMaterial() const
 
 void Object::SetMesh(const EngineContext& engineContext, const std::string& tag)
 {
-    mesh = engineContext.renderManager->GetMeshByTag(tag);
+    SetMesh(engineContext.renderManager->GetMeshByTag(tag));
+}
+
+void Object::SetMesh(const EngineContext& engineContext, StringID tag)
+{
+    SetMesh(engineContext.renderManager->GetMeshByTag(tag));
+}
+
+void Object::SetMesh(Mesh* mesh_)
+{
+    mesh = mesh_;
+    if (ComponentRow& row = transform2D.row; row.store)
+        row.store->meshes[row.index] = mesh;
 }
 
 Mesh* Object::GetMesh() const
@@ -81,6 +169,8 @@ Transform2D& Object::GetTransform2D()
 void Object::SetColor(const  glm::vec4& color_)
 {
     color = color_;
+    if (ComponentRow& row = transform2D.row; row.store)
+        row.store->colors[row.index] = color;
 }
 
 const glm::vec4& Object::GetColor()
@@ -88,6 +178,39 @@ const glm::vec4& Object::GetColor()
     return color;
 }
 
+void Object::AttachAnimator(std::unique_ptr<SpriteAnimator> anim)
+{
+    spriteAnimator = std::move(anim);
+    if (ComponentRow& row = transform2D.row; row.store)
+    {
+        row.store->animators[row.index] = spriteAnimator.get();
+        row.store->uvOffsets[row.index] = spriteAnimator ? spriteAnimator->GetUVOffset() : glm::vec2(0.f);
+        row.store->uvScales[row.index] = spriteAnimator ? spriteAnimator->GetUVScale() : glm::vec2(1.f);
+    }
+}
+
+void Object::SetCollider(std::unique_ptr<Collider> c)
+{
+    collider = std::move(c);
+    SyncColliderRow();
+}
+
+void Object::SyncColliderRow()
+{
+    ComponentRow& row = transform2D.row;
+    if (!row.store)
+        return;
+
+    row.store->colliders[row.index] = collider.get();
+    row.store->colliderDirty[row.index] = 1;
+
+    uint8_t& flags = row.store->flags[row.index];
+    if (collider && collider->IsStatic())
+        flags |= ObjectComponentStore::ROW_STATIC_COLLIDER;
+    else
+        flags &= ~ObjectComponentStore::ROW_STATIC_COLLIDER;
+}
+
 void Object::SetCollision(ObjectManager& objectManager, const std::string& tag, const std::vector<std::string>& checkCollisionList)
 {
     auto& reg = objectManager.GetCollisionGroupRegistry();
@@ -110,6 +233,8 @@ void Object::SetIgnoreCamera(bool shouldIgnoreCamera, Camera2D* cameraForTransfo
     {
         referenceCamera = cameraForTransformCalc;
     }
+    if (ComponentRow& row = transform2D.row; row.store)
+        row.store->flags[row.index] = ObjectComponentStore::MakeFlags(*this);
 }
 
 glm::vec2 Object::GetWorldPosition() const
@@ -140,6 +265,20 @@ glm::vec2 Object::GetWorldScale() const
         return transform2D.GetScale();
 }
 
+void Object::SetFlipUV_X(bool shouldFlip)
+{
+    flipUV_X = shouldFlip;
+    if (ComponentRow& row = transform2D.row; row.store)
+        row.store->uvFlips[row.index] = GetUVFlipVector();
+}
+
+void Object::SetFlipUV_Y(bool shouldFlip)
+{
+    flipUV_Y = shouldFlip;
+    if (ComponentRow& row = transform2D.row; row.store)
+        row.store->uvFlips[row.index] = GetUVFlipVector();
+}
+
 glm::vec2 Object::GetUVFlipVector() const
 {
     return { flipUV_X ? -1.0f : 1.0f, flipUV_Y ? -1.0f : 1.0f };
@@ -0,0 +1,75 @@
+#include "Engine.h"
+
+#include <algorithm>
+#include <new>
+
+ObjectBlockPool::ObjectBlockPool(size_t blockSize_, size_t blockAlign_, size_t firstChunkBlocks)
+    : blockAlign(std::max(blockAlign_, alignof(FreeNode))), nextChunkBlocks(std::max<size_t>(firstChunkBlocks, 1))
+{
+    //every block has to hold a free-list node and keep the next block aligned
+    blockSize = std::max(blockSize_, sizeof(FreeNode));
+    blockSize = (blockSize + blockAlign - 1) / blockAlign * blockAlign;
+}
+
+ObjectBlockPool::~ObjectBlockPool()
+{
+    if (liveCount > 0)
+        SNAKE_WRN("ObjectBlockPool destroyed with " << liveCount << " live objects.");
+
+    for (void* chunk : chunks)
+        ::operator delete(chunk, std::align_val_t(blockAlign));
+}
+
+void* ObjectBlockPool::Allocate()
+{
+    if (!freeList)
+        AddChunk();
+
+    FreeNode* node = freeList;
+    freeList = node->next;
+    ++liveCount;
+    return node;
+}
+
+void ObjectBlockPool::Deallocate(void* block)
+{
+    if (!block)
+        return;
+
+    FreeNode* node = static_cast<FreeNode*>(block);
+    node->next = freeList;
+    freeList = node;
+    --liveCount;
+}
+
+void ObjectBlockPool::AddChunk()
+{
+    const size_t blockCount = nextChunkBlocks;
+    unsigned char* chunk = static_cast<unsigned char*>(::operator new(blockSize * blockCount, std::align_val_t(blockAlign)));
+    chunks.push_back(chunk);
+
+    //thread the new blocks in address order so consecutive spawns stay contiguous
+    for (size_t i = blockCount; i-- > 0;)
+    {
+        FreeNode* node = reinterpret_cast<FreeNode*>(chunk + i * blockSize);
+        node->next = freeList;
+        freeList = node;
+    }
+
+    capacity += blockCount;
+    nextChunkBlocks = std::min<size_t>(nextChunkBlocks * 2, 1024);
+}
+
+void ObjectDeleter::operator()(Object* obj) const
+{
+    if (!pool)
+    {
+        delete obj;
+        return;
+    }
+
+    //the block starts at the most-derived object, which is not necessarily where the Object base sits
+    void* block = dynamic_cast<void*>(obj);
+    obj->~Object();
+    pool->Deallocate(block);
+}
@@ -0,0 +1,243 @@
+#include "Engine.h"
+
+#include <cmath>
+
+namespace
+{
+    template<typename T>
+    void SwapPop(std::vector<T>& column, uint32_t row)
+    {
+        if (row != column.size() - 1)
+            column[row] = std::move(column.back());
+        column.pop_back();
+    }
+
+    template<typename... Columns>
+    void SwapPopColumns(uint32_t row, Columns&... columns)
+    {
+        (SwapPop(columns, row), ...);
+    }
+
+    template<typename... Columns>
+    void ClearColumns(Columns&... columns)
+    {
+        (columns.clear(), ...);
+    }
+
+    template<typename... Columns>
+    void ReserveColumns(size_t capacity, Columns&... columns)
+    {
+        (columns.reserve(capacity), ...);
+    }
+}
+
+void ObjectComponentStore::Bind(Object* obj)
+{
+    if (obj->transform2D.row.IsBound())
+    {
+        SNAKE_WRN("Object is already bound to a component store.");
+        return;
+    }
+
+    const uint32_t row = static_cast<uint32_t>(owners.size());
+    const Transform2D& transform = obj->transform2D;
+    SpriteAnimator* animator = obj->spriteAnimator.get();
+
+    owners.push_back(obj);
+
+    positions.push_back(transform.position);
+    rotations.push_back(transform.rotation);
+    scales.push_back(transform.scale);
+    matrices.push_back(transform.matrix);
+    matrixDirty.push_back(transform.isChanged ? 1 : 0);
+
+    colors.push_back(obj->color);
+    uvFlips.push_back(obj->GetUVFlipVector());
+    flags.push_back(MakeFlags(*obj));
+    renderLayers.push_back(UNRESOLVED_LAYER);
+    meshes.push_back(obj->mesh);
+    materials.push_back(obj->material);
+
+    animators.push_back(animator);
+    uvOffsets.push_back(animator ? animator->GetUVOffset() : glm::vec2(0.f));
+    uvScales.push_back(animator ? animator->GetUVScale() : glm::vec2(1.f));
+
+    colliders.push_back(obj->collider.get());
+    colliderBounds.push_back({ transform.position, transform.position });
+    colliderShapes.push_back({ transform.position });
+    colliderDirty.push_back(1);
+
+    visibleFrames.push_back(0);
+
+    obj->transform2D.row = { this, row };
+    //Init may have scaled the object after attaching its collider, and queries can run before the next collision pass
+    SyncCollider(row);
+}
+
+void ObjectComponentStore::Unbind(Object* obj)
+{
+    ComponentRow& binding = obj->transform2D.row;
+    if (binding.store != this)
+        return;
+
+    const uint32_t row = binding.index;
+    WriteBack(row);
+
+    SwapPopColumns(row, owners, positions, rotations, scales, matrices, matrixDirty,
+        colors, uvFlips, flags, renderLayers, meshes, materials,
+        animators, uvOffsets, uvScales, colliders, colliderBounds, colliderShapes, colliderDirty, visibleFrames);
+
+    if (row < owners.size())
+        owners[row]->transform2D.row.index = row;
+}
+
+void ObjectComponentStore::Clear()
+{
+    for (uint32_t row = 0; row < owners.size(); ++row)
+        WriteBack(row);
+
+    ClearColumns(owners, positions, rotations, scales, matrices, matrixDirty,
+        colors, uvFlips, flags, renderLayers, meshes, materials,
+        animators, uvOffsets, uvScales, colliders, colliderBounds, colliderShapes, colliderDirty, visibleFrames);
+}
+
+void ObjectComponentStore::Reserve(size_t capacity)
+{
+    if (capacity <= owners.capacity())
+        return;
+
+    ReserveColumns(capacity, owners, positions, rotations, scales, matrices, matrixDirty,
+        colors, uvFlips, flags, renderLayers, meshes, materials,
+        animators, uvOffsets, uvScales, colliders, colliderBounds, colliderShapes, colliderDirty, visibleFrames);
+}
+
+void ObjectComponentStore::WriteBack(uint32_t row)
+{
+    //an unbound object (parked in a pool, or outliving its manager) keeps working from its own members
+    Transform2D& transform = owners[row]->transform2D;
+    transform.position = positions[row];
+    transform.rotation = rotations[row];
+    transform.scale = scales[row];
+    transform.matrix = matrices[row];
+    transform.isChanged = matrixDirty[row] != 0;
+    transform.row = {};
+}
+
+void ObjectComponentStore::UpdateAnimators(float dt, JobSystem* jobSystem)
+{
+    auto updateRange = [this, dt](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+                if (!(flags[i] & (ROW_ASLEEP | ROW_TIERED_UPDATE)))
+                    UpdateAnimator(static_cast<uint32_t>(i), dt);
+        };
+
+    if (jobSystem)
+        jobSystem->ParallelFor(owners.size(), PARALLEL_GRAIN_SIZE, updateRange);
+    else
+        updateRange(0, owners.size());
+}
+
+void ObjectComponentStore::UpdateAnimator(uint32_t row, float dt)
+{
+    SpriteAnimator* animator = animators[row];
+    if (!animator || !(flags[row] & ROW_ALIVE))
+        return;
+
+    animator->Update(dt);
+    uvOffsets[row] = animator->GetUVOffset();
+    uvScales[row] = animator->GetUVScale();
+}
+
+void ObjectComponentStore::SyncColliders(JobSystem* jobSystem)
+{
+    if (!jobSystem)
+    {
+        for (size_t i = 0; i < owners.size(); ++i)
+            SyncCollider(i);
+        return;
+    }
+
+    //custom-bounds rows ask the object for its world position, which may not be safe off the main thread
+    jobSystem->ParallelFor(owners.size(), PARALLEL_GRAIN_SIZE, [this](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+                if (!(flags[i] & ROW_CUSTOM_BOUNDS))
+                    SyncCollider(i);
+        });
+    for (size_t i = 0; i < owners.size(); ++i)
+        if (flags[i] & ROW_CUSTOM_BOUNDS)
+            SyncCollider(i);
+}
+
+void ObjectComponentStore::SyncCollider(size_t row)
+{
+    Collider* collider = colliders[row];
+    if (!collider || !(flags[row] & ROW_ALIVE))
+        return;
+    if ((flags[row] & (ROW_ASLEEP | ROW_STATIC_COLLIDER)) && !colliderDirty[row])
+        return;
+    colliderDirty[row] = 0;
+    if (flags[row] & ROW_STATIC_COLLIDER)
+        staticCollidersChanged.store(true, std::memory_order_relaxed);
+
+    collider->SyncWithTransformScale();
+
+    //the only place the world scale is read per frame; every collision stage reads these two columns
+    const glm::vec2 center = (flags[row] & ROW_CUSTOM_BOUNDS) ? owners[row]->GetWorldPosition() : positions[row];
+    const glm::vec2 extent = collider->GetShapeExtent();
+    colliderBounds[row] = { center - extent, center + extent };
+    colliderShapes[row] = { center, extent, collider->GetType() };
+}
+
+void ObjectComponentStore::MarkVisible(const std::vector<uint32_t>& rows)
+{
+    for (uint32_t row : rows)
+        visibleFrames[row] = visibilityFrame;
+}
+
+glm::mat4& ObjectComponentStore::GetMatrix(uint32_t row)
+{
+    glm::mat4& matrix = matrices[row];
+    if (matrixDirty[row])
+    {
+        //translate * rotate(z) * scale written out directly for the 2D case
+        const float c = std::cos(rotations[row]);
+        const float s = std::sin(rotations[row]);
+        const glm::vec2& scale = scales[row];
+        const glm::vec2& position = positions[row];
+
+        matrix = glm::mat4(1.0f);
+        matrix[0] = glm::vec4(c * scale.x, s * scale.x, 0.f, 0.f);
+        matrix[1] = glm::vec4(-s * scale.y, c * scale.y, 0.f, 0.f);
+        matrix[3] = glm::vec4(position, 0.f, 1.f);
+        matrixDirty[row] = 0;
+    }
+    return matrix;
+}
+
+uint8_t ObjectComponentStore::MakeFlags(const Object& obj)
+{
+    uint8_t result = 0;
+    if (obj.isAlive)
+        result |= ROW_ALIVE;
+    if (obj.isVisible)
+        result |= ROW_VISIBLE;
+    if (obj.ignoreCamera)
+        result |= ROW_IGNORE_CAMERA;
+    if (obj.ignoreCamera || obj.GetType() == ObjectType::TEXT)
+        result |= ROW_CUSTOM_BOUNDS;
+    if (obj.collider && obj.collider->IsStatic())
+        result |= ROW_STATIC_COLLIDER;
+    return result | MakeUpdateFlags(obj);
+}
+
+uint8_t ObjectComponentStore::MakeUpdateFlags(const Object& obj)
+{
+    uint8_t result = 0;
+    if (obj.isAsleep)
+        result |= ROW_ASLEEP;
+    if (obj.updatePolicy != UpdatePolicy::EveryFrame)
+        result |= ROW_TIERED_UPDATE;
+    return result;
+}
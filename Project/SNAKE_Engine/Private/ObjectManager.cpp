@@ -2,29 +2,313 @@
 
 #include <cassert>
 #include <algorithm>
-#include <unordered_set>
+#include <bit>
+
+namespace
+{
+    bool ShapeOverlapsAABB(const ColliderShape& shape, const glm::vec2& boundsMin, const glm::vec2& boundsMax)
+    {
+        if (shape.type == ColliderType::Circle)
+        {
+            const glm::vec2 offset = shape.center - glm::clamp(shape.center, boundsMin, boundsMax);
+            return glm::dot(offset, offset) <= shape.extent.x * shape.extent.x;
+        }
+        return shape.center.x - shape.extent.x <= boundsMax.x && boundsMin.x <= shape.center.x + shape.extent.x &&
+            shape.center.y - shape.extent.y <= boundsMax.y && boundsMin.y <= shape.center.y + shape.extent.y;
+    }
+
+    float DistanceToShape(const ColliderShape& shape, const glm::vec2& point)
+    {
+        if (shape.type == ColliderType::Circle)
+            return std::max(glm::length(point - shape.center) - shape.extent.x, 0.f);
+        return glm::length(glm::max(glm::abs(point - shape.center) - shape.extent, glm::vec2(0.f)));
+    }
+
+    //direction must be normalized; outDistance is 0 when origin starts inside
+    bool RaycastShape(const ColliderShape& shape, const glm::vec2& origin, const glm::vec2& direction, float maxDistance, float& outDistance, glm::vec2& outNormal)
+    {
+        if (shape.type == ColliderType::Circle)
+        {
+            const glm::vec2 offset = origin - shape.center;
+            const float b = glm::dot(offset, direction);
+            const float c = glm::dot(offset, offset) - shape.extent.x * shape.extent.x;
+            if (c <= 0.f)
+            {
+                outDistance = 0.f;
+                outNormal = -direction;
+                return true;
+            }
+            const float discriminant = b * b - c;
+            if (b > 0.f || discriminant < 0.f)
+                return false;
+
+            outDistance = -b - std::sqrt(discriminant);
+            if (outDistance > maxDistance)
+                return false;
+            outNormal = (origin + direction * outDistance - shape.center) / shape.extent.x;
+            return true;
+        }
+
+        //slab test, remembering which face the ray entered through
+        float entry = 0.f;
+        float exit = maxDistance;
+        glm::vec2 normal = -direction;
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            const float slabMin = shape.center[axis] - shape.extent[axis];
+            const float slabMax = shape.center[axis] + shape.extent[axis];
+            if (std::abs(direction[axis]) < 1e-8f)
+            {
+                if (origin[axis] < slabMin || origin[axis] > slabMax)
+                    return false;
+                continue;
+            }
+
+            const float inverse = 1.f / direction[axis];
+            float near = (slabMin - origin[axis]) * inverse;
+            float far = (slabMax - origin[axis]) * inverse;
+            if (near > far)
+                std::swap(near, far);
+            if (near > entry)
+            {
+                entry = near;
+                normal = glm::vec2(0.f);
+                normal[axis] = direction[axis] > 0.f ? -1.f : 1.f;
+            }
+            exit = std::min(exit, far);
+            if (entry > exit)
+                return false;
+        }
+
+        outDistance = entry;
+        outNormal = normal;
+        return true;
+    }
+}
 
 Object* ObjectManager::AddObject(std::unique_ptr<Object> obj, const std::string& tag)
 {
-    assert(obj != nullptr && "Cannot add null object");
+    return AddObject(ObjectPtr(obj.release()), tag);
+}
 
-    obj->SetTag(tag);
+Object* ObjectManager::AddObject(ObjectPtr obj, const std::string& tag)
+{
+    assert(obj != nullptr && "Cannot add null object");
 
-    if (!tag.empty())
+    StringID tagID = tag.empty() ? StringID() : StringID::Intern(tag);
+    if (tagID.IsValid())
     {
-        if (objectMap.find(tag) != objectMap.end())
+        if (objectMap.find(tagID) != objectMap.end())
             SNAKE_LOG("Duplicate Object ID");
+    }
 
-        Object* rawPointer = obj.get();
-        objectMap[tag] = rawPointer;
+    Object* returnVal = Register(std::move(obj), tag, tagID);
+    if (tagID.IsValid())
+        objectMap[tagID] = returnVal->handle;
+    return returnVal;
+}
+
+Object* ObjectManager::AddPooledObject(ObjectPtr obj, const std::string& tag, StringID tagID)
+{
+    Object* returnVal = Register(std::move(obj), tag, tagID);
+    if (tagID.IsValid())
+        objectMap[tagID] = returnVal->handle;
+    return returnVal;
+}
+
+Object* ObjectManager::Register(ObjectPtr obj, const std::string& tag, StringID tagID)
+{
+    //a recycled pool object still carries its tag
+    if (obj->objectTagID != tagID)
+    {
+        obj->objectTag = tag;
+        obj->objectTagID = tagID;
     }
+    obj->handle = AllocateHandle(obj.get());
+    obj->ownerManager = this;
+
+    if (tagID.IsValid())
+        AddToTagIndex(obj.get());
 
     Object* returnVal = obj.get();
+    obj->rawPtrIndex = rawPtrObjects.size();
     rawPtrObjects.push_back(obj.get());
     pendingObjects.push_back(std::move(obj));
     return returnVal;
 }
 
+void ObjectManager::ReserveForBatch(size_t count, StringID tagID)
+{
+    rawPtrObjects.reserve(rawPtrObjects.size() + count);
+    pendingObjects.reserve(pendingObjects.size() + count);
+    if (freeSlots.size() < count)
+        slots.reserve(slots.size() + count - freeSlots.size());
+    if (tagID.IsValid())
+    {
+        std::vector<Object*>& list = tagIndex[tagID];
+        list.reserve(list.size() + count);
+    }
+}
+
+ObjectManager::ResolvedPrefab ObjectManager::ResolvePrefab(const EngineContext& engineContext, const Prefab& prefab)
+{
+    ResolvedPrefab resolved;
+    if (!prefab.tag.empty())
+        resolved.tagID = StringID::Intern(prefab.tag);
+    if (!prefab.renderLayer.empty())
+        resolved.renderLayerID = StringID(prefab.renderLayer);
+
+    RenderManager* renderManager = engineContext.renderManager;
+    if (!prefab.meshTag.empty())
+        resolved.mesh = renderManager->GetMeshByTag(prefab.meshTag);
+    if (!prefab.materialTag.empty())
+        resolved.material = renderManager->GetMaterialByTag(prefab.materialTag);
+    if (!prefab.spriteSheetTag.empty())
+        resolved.spriteSheet = renderManager->GetSpriteSheetByTag(prefab.spriteSheetTag);
+    if (!prefab.animationClip.empty())
+        resolved.animationClip = StringID(prefab.animationClip);
+
+    if (!prefab.collisionGroup.empty())
+    {
+        resolved.collisionCategory = collisionGroupRegistry.GetGroupBit(prefab.collisionGroup);
+        for (const std::string& group : prefab.collidesWith)
+            resolved.collisionMask |= collisionGroupRegistry.GetGroupBit(group);
+    }
+    return resolved;
+}
+
+void ObjectManager::ApplyPrefab(Object& obj, const Prefab& prefab, const ResolvedPrefab& resolved)
+{
+    if (resolved.mesh)
+        obj.SetMesh(resolved.mesh);
+    if (resolved.material)
+        obj.SetMaterial(resolved.material);
+    if (resolved.renderLayerID.IsValid())
+    {
+        obj.renderLayerTag = prefab.renderLayer;
+        obj.renderLayerTagID = resolved.renderLayerID;
+    }
+
+    if (prefab.scale)
+        obj.GetTransform2D().SetScale(*prefab.scale);
+    if (prefab.color)
+        obj.SetColor(*prefab.color);
+
+    if (prefab.colliderFactory)
+        obj.SetCollider(prefab.colliderFactory(&obj));
+    if (!prefab.collisionGroup.empty())
+    {
+        obj.collisionCategory = resolved.collisionCategory;
+        obj.collisionMask = resolved.collisionMask;
+    }
+
+    if (resolved.spriteSheet)
+    {
+        obj.AttachAnimator(resolved.spriteSheet, prefab.frameTime, prefab.loopAnimation);
+        if (resolved.animationClip.IsValid())
+            obj.GetAnimator()->PlayClip(resolved.animationClip);
+    }
+
+    if (prefab.updatePolicy)
+        obj.SetUpdatePolicy(*prefab.updatePolicy, prefab.updateInterval);
+}
+
+void ObjectManager::AddToTagIndex(Object* obj)
+{
+    std::vector<Object*>& list = tagIndex[obj->GetTagID()];
+    obj->tagIndexSlot = list.size();
+    list.push_back(obj);
+}
+
+void ObjectManager::Retag(Object* obj, const std::string& tag)
+{
+    const StringID tagID = tag.empty() ? StringID() : StringID::Intern(tag);
+    if (tagID == obj->objectTagID)
+        return;
+
+    auto mapIt = objectMap.find(obj->objectTagID);
+    if (mapIt != objectMap.end() && mapIt->second == obj->handle)
+        objectMap.erase(mapIt);
+    RemoveFromTagIndex(obj);
+
+    obj->objectTag = tag;
+    obj->objectTagID = tagID;
+    if (tagID.IsValid())
+    {
+        AddToTagIndex(obj);
+        objectMap[tagID] = obj->handle;
+    }
+}
+
+void ObjectManager::RemoveFromTagIndex(Object* obj)
+{
+    auto it = tagIndex.find(obj->GetTagID());
+    if (it == tagIndex.end())
+        return;
+
+    std::vector<Object*>& list = it->second;
+    size_t slot = obj->tagIndexSlot;
+    if (slot >= list.size() || list[slot] != obj)
+        return;
+
+    if (slot != list.size() - 1)
+    {
+        list[slot] = list.back();
+        list[slot]->tagIndexSlot = slot;
+    }
+    list.pop_back();
+}
+
+ObjectBlockPool& ObjectManager::GetBlockPool(std::type_index type, size_t size, size_t align)
+{
+    std::unique_ptr<ObjectBlockPool>& pool = blockPools[type];
+    if (!pool)
+        pool = std::make_unique<ObjectBlockPool>(size, align);
+    return *pool;
+}
+
+ObjectHandle ObjectManager::AllocateHandle(Object* obj)
+{
+    uint32_t index;
+    if (!freeSlots.empty())
+    {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+    slots[index].object = obj;
+    return { index, slots[index].generation };
+}
+
+void ObjectManager::ReleaseHandle(ObjectHandle handle)
+{
+    ObjectSlot& slot = slots[handle.index];
+    slot.object = nullptr;
+    //bumping the generation invalidates every copy of the old handle before the slot is reused
+    ++slot.generation;
+    freeSlots.push_back(handle.index);
+}
+
+bool ObjectManager::IsRegistered(const Object* obj) const
+{
+    const ObjectHandle handle = obj->handle;
+    return handle.index < slots.size() && slots[handle.index].object == obj && slots[handle.index].generation == handle.generation;
+}
+
+Object* ObjectManager::Get(ObjectHandle handle) const
+{
+    if (handle.index >= slots.size())
+        return nullptr;
+    const ObjectSlot& slot = slots[handle.index];
+    if (slot.generation != handle.generation || !slot.object || !slot.object->IsAlive())
+        return nullptr;
+    return slot.object;
+}
+
 void ObjectManager::InitAll(const EngineContext& engineContext)
 {
     for (const auto& obj : objects)
@@ -36,37 +320,199 @@ void ObjectManager::InitAll(const EngineContext& engineContext)
 
 void ObjectManager::UpdateAll(float dt, const EngineContext& engineContext)
 {
-    for (const auto& obj : objects)
+    jobSystem = isParallelUpdate ? engineContext.jobSystem : nullptr;
+
+    updateTime += dt;
+    ++updateFrame;
+    WakeTimedSleepers();
+    CollectDueUpdates(dt);
+
+    if (jobSystem)
     {
+        parallelUpdates.clear();
+        for (const DueUpdate& due : dueUpdates)
+            if (ShouldUpdateInParallel(due.object))
+                parallelUpdates.push_back(due);
+
+        jobSystem->ParallelFor(parallelUpdates.size(), ObjectComponentStore::PARALLEL_GRAIN_SIZE, [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                    parallelUpdates[i].object->Update(parallelUpdates[i].dt, engineContext);
+            });
+    }
+
+    for (const DueUpdate& due : dueUpdates)
+    {
+        Object* obj = due.object;
         if (obj->IsAlive())
         {
+            if (jobSystem && ShouldUpdateInParallel(obj))
+                continue;
             if (obj->GetType()==ObjectType::TEXT)
             {
-                static_cast<TextObject*>(obj.get())->CheckFontAtlasAndMeshUpdate();
+                static_cast<TextObject*>(obj)->CheckFontAtlasAndMeshUpdate();
             }
-            obj->Update(dt, engineContext);
-            if (obj->HasAnimation())
-                obj->GetAnimator()->Update(dt);
-            if (Collider* col = obj->GetCollider())
-                col->SyncWithTransformScale();
+            obj->Update(due.dt, engineContext);
         }
     }
 
+    //tiered objects step their animator only on the frames they are due
+    for (const DueUpdate& due : dueUpdates)
+    {
+        const ComponentRow& row = due.object->transform2D.row;
+        if (due.object->updatePolicy != UpdatePolicy::EveryFrame && row.store == &componentStore)
+            componentStore.UpdateAnimator(row.index, due.dt);
+    }
+
     EraseDeadObjects(engineContext);
     AddAllPendingObjects(engineContext);
+
+    componentStore.UpdateAnimators(dt, jobSystem);
+    componentStore.AdvanceVisibilityFrame();
+}
+
+bool ObjectManager::ShouldUpdateInParallel(const Object* obj) const
+{
+    return obj->IsAlive() && obj->IsThreadSafeUpdate() && obj->GetType() != ObjectType::TEXT;
+}
+
+void ObjectManager::CollectDueUpdates(float dt)
+{
+    dueUpdates.clear();
+
+    for (Object* obj : everyFrameObjects)
+        dueUpdates.push_back({ obj, dt });
+
+    for (auto& [interval, tier] : intervalTiers)
+    {
+        const uint32_t phase = static_cast<uint32_t>(updateFrame % interval);
+        const float phaseDt = updateTime - tier.phaseLastUpdateTime[phase];
+        tier.phaseLastUpdateTime[phase] = updateTime;
+        for (Object* obj : tier.phases[phase])
+            dueUpdates.push_back({ obj, phaseDt });
+    }
+
+    for (Object* obj : whenVisibleObjects)
+        if (componentStore.WasVisible(obj->transform2D.row.index))
+            dueUpdates.push_back({ obj, dt });
+}
+
+void ObjectManager::RefreshUpdateTier(Object* obj)
+{
+    RemoveFromUpdateTier(obj);
+    //pending objects join their tier once they are bound
+    if (obj->transform2D.row.store == &componentStore && obj->IsAlive())
+        AddToUpdateTier(obj);
+}
+
+void ObjectManager::AddToUpdateTier(Object* obj)
+{
+    if (obj->isInUpdateTier || obj->isAsleep)
+        return;
+
+    std::vector<Object*>* list = nullptr;
+    switch (obj->updatePolicy)
+    {
+    case UpdatePolicy::EveryFrame:
+        list = &everyFrameObjects;
+        break;
+    case UpdatePolicy::WhenVisible:
+        list = &whenVisibleObjects;
+        break;
+    case UpdatePolicy::Interval:
+    {
+        IntervalTier& tier = intervalTiers[obj->updateInterval];
+        if (tier.phases.empty())
+        {
+            tier.phases.resize(obj->updateInterval);
+            tier.phaseLastUpdateTime.assign(obj->updateInterval, updateTime);
+        }
+        obj->updateTierPhase = tier.nextPhase;
+        tier.nextPhase = (tier.nextPhase + 1) % obj->updateInterval;
+        list = &tier.phases[obj->updateTierPhase];
+        break;
+    }
+    }
+
+    obj->updateTierSlot = list->size();
+    obj->isInUpdateTier = true;
+    list->push_back(obj);
+}
+
+void ObjectManager::RemoveFromUpdateTier(Object* obj)
+{
+    if (!obj->isInUpdateTier)
+        return;
+    obj->isInUpdateTier = false;
+
+    std::vector<Object*>* list = nullptr;
+    switch (obj->updatePolicy)
+    {
+    case UpdatePolicy::EveryFrame:
+        list = &everyFrameObjects;
+        break;
+    case UpdatePolicy::WhenVisible:
+        list = &whenVisibleObjects;
+        break;
+    case UpdatePolicy::Interval:
+        list = &intervalTiers[obj->updateInterval].phases[obj->updateTierPhase];
+        break;
+    }
+
+    size_t slot = obj->updateTierSlot;
+    if (slot >= list->size() || (*list)[slot] != obj)
+        return;
+
+    if (slot != list->size() - 1)
+    {
+        (*list)[slot] = list->back();
+        (*list)[slot]->updateTierSlot = slot;
+    }
+    list->pop_back();
+}
+
+void ObjectManager::ScheduleWakeUp(Object* obj, float wakeAfterSeconds)
+{
+    sleepTimers.push({ updateTime + wakeAfterSeconds, obj->handle, obj->sleepGeneration });
+}
+
+void ObjectManager::WakeTimedSleepers()
+{
+    while (!sleepTimers.empty() && sleepTimers.top().wakeTime <= updateTime)
+    {
+        SleepTimer timer = sleepTimers.top();
+        sleepTimers.pop();
+
+        //a newer Sleep or WakeUp bumped the generation and superseded this timer
+        Object* obj = Get(timer.handle);
+        if (obj && obj->isAsleep && obj->sleepGeneration == timer.sleepGeneration)
+            obj->WakeUp();
+    }
 }
 
 void ObjectManager::AddAllPendingObjects(const EngineContext& engineContext)
 {
-    std::vector<std::unique_ptr<Object>> tmp;
+    std::vector<ObjectPtr> tmp;
     std::swap(tmp, pendingObjects);
 
+    objects.reserve(objects.size() + tmp.size());
+    componentStore.Reserve(componentStore.GetSize() + tmp.size());
+
+    //recycled pool objects were initialized on their first spawn and only got OnAcquire
     for (auto& obj : tmp)
-        obj->Init(engineContext);
+        if (!obj->isPoolInitialized)
+            obj->Init(engineContext);
 
     for (auto& obj : tmp)
     {
-        obj->LateInit(engineContext);
+        if (!obj->isPoolInitialized)
+        {
+            obj->LateInit(engineContext);
+            obj->isPoolInitialized = obj->ownerPool != nullptr;
+        }
+        obj->objectIndex = objects.size();
+        componentStore.Bind(obj.get());
+        AddToUpdateTier(obj.get());
         objects.push_back(std::move(obj));
     }
 }
@@ -80,28 +526,63 @@ void ObjectManager::EraseDeadObjects(const EngineContext& engineContext)
             deadObjects.push_back(obj.get());
     }
 
+    if (deadObjects.empty())
+        return;
+
+    DispatchExitsForDeadObjects();
+    erasedSinceCollision.insert(erasedSinceCollision.end(), deadObjects.begin(), deadObjects.end());
+    isErasedSorted = false;
+
     for (auto& obj : deadObjects)
-        obj->Free(engineContext);
+        if (!obj->ownerPool)
+            obj->Free(engineContext);
 
     for (auto& obj : deadObjects)
+        if (!obj->ownerPool)
+            obj->LateFree(engineContext);
+
+    //each object knows its own slots, so removal is a swap with the last element instead of a search
+    for (Object* obj : deadObjects)
     {
-        obj->LateFree(engineContext);
-        objectMap.erase(obj->GetTag());
-        rawPtrObjects.erase(std::remove(rawPtrObjects.begin(), rawPtrObjects.end(), obj), rawPtrObjects.end());
-    }
+        auto tagIt = objectMap.find(obj->GetTagID());
+        if (tagIt != objectMap.end() && tagIt->second == obj->handle)
+            objectMap.erase(tagIt);
+        RemoveFromTagIndex(obj);
 
-    objects.erase(
-        std::remove_if(objects.begin(), objects.end(),
-            [&](const std::unique_ptr<Object>& obj)
-            {
-                return std::find(deadObjects.begin(), deadObjects.end(), obj.get()) != deadObjects.end();
-            }),
-        objects.end());
+        size_t rawIndex = obj->rawPtrIndex;
+        if (rawIndex != rawPtrObjects.size() - 1)
+        {
+            rawPtrObjects[rawIndex] = rawPtrObjects.back();
+            rawPtrObjects[rawIndex]->rawPtrIndex = rawIndex;
+        }
+        rawPtrObjects.pop_back();
+
+        ReleaseHandle(obj->handle);
+        RemoveFromUpdateTier(obj);
+        componentStore.Unbind(obj);
+
+        size_t index = obj->objectIndex;
+        ObjectPtr dead = std::move(objects[index]);
+        if (index != objects.size() - 1)
+        {
+            objects[index] = std::move(objects.back());
+            objects[index]->objectIndex = index;
+        }
+        objects.pop_back();
+
+        if (ObjectPoolBase* pool = dead->ownerPool)
+            pool->Park(std::move(dead));
+    }
 }
 
 void ObjectManager::DrawAll(const EngineContext& engineContext)
 {
-    engineContext.renderManager->Submit(rawPtrObjects, engineContext);
+    engineContext.renderManager->Submit(componentStore, engineContext);
+}
+
+void ObjectManager::PrepareDraw(const EngineContext& engineContext)
+{
+    engineContext.renderManager->PrepareSubmit(componentStore, engineContext);
 }
 
 void ObjectManager::DrawObjects(const EngineContext& engineContext, const std::vector<Object*>& objects)
@@ -124,61 +605,520 @@ void ObjectManager::FreeAll(const EngineContext& engineContext)
     for (const auto& obj : objects)
         obj->LateFree(engineContext);
 
+    for (const auto& obj : objects)
+    {
+        ReleaseHandle(obj->handle);
+        obj->isInUpdateTier = false;
+    }
+
+    componentStore.Clear();
+    for (CategoryBucket& bucket : categoryBuckets)
+    {
+        if (bucket.broadPhase)
+            bucket.broadPhase->Reset();
+        bucket.rows.clear();
+        bucket.categories = 0;
+        bucket.masks = 0;
+    }
+    categoryInteractions.fill(0);
+    dynamicColliderCount = 0;
+    staticColliderGrid.Reset();
+    staticColliderCount = 0;
+    staticCategories = 0;
+    staticMasks = 0;
+    contactCache.clear();
+    erasedSinceCollision.clear();
+    isErasedSorted = true;
+    everyFrameObjects.clear();
+    whenVisibleObjects.clear();
+    intervalTiers.clear();
+    sleepTimers = {};
+
+    for (const auto& pool : objectPools)
+        pool->FreeParked(engineContext);
+    objectPools.clear();
+
     objects.clear();
     objectMap.clear();
+    tagIndex.clear();
     rawPtrObjects.clear();
+
+    for (const auto& obj : pendingObjects)
+    {
+        //its pool is gone, so it is freed like any other object when it dies
+        obj->ownerPool = nullptr;
+        obj->rawPtrIndex = rawPtrObjects.size();
+        rawPtrObjects.push_back(obj.get());
+        if (!obj->GetTag().empty())
+            AddToTagIndex(obj.get());
+    }
 }
 
 Object* ObjectManager::FindByTag(const std::string& tag) const
+{
+    return FindByTag(StringID(tag));
+}
+
+Object* ObjectManager::FindByTag(StringID tag) const
 {
     auto it = objectMap.find(tag);
-    if (it != objectMap.end() && it->second->IsAlive())
-        return it->second;
+    if (it != objectMap.end())
+        return Get(it->second);
     return nullptr;
 }
 
 void ObjectManager::FindByTag(const std::string& tag, std::vector<Object*>& result)
 {
-    for (Object* obj : rawPtrObjects)
+    FindByTag(StringID(tag), result);
+}
+
+void ObjectManager::FindByTag(StringID tag, std::vector<Object*>& result)
+{
+    auto it = tagIndex.find(tag);
+    if (it == tagIndex.end())
+        return;
+
+    for (Object* obj : it->second)
     {
-        if (obj && obj->IsAlive() && obj->GetTag() == tag)
+        if (obj->IsAlive())
             result.push_back(obj);
     }
 }
+
+ObjectQuery ObjectManager::Query(StringID tag) const
+{
+    static const std::vector<Object*> emptyList;
+
+    auto it = tagIndex.find(tag);
+    return ObjectQuery(it != tagIndex.end() ? it->second : emptyList);
+}
 void ObjectManager::CheckCollision()
 {
-    std::unordered_set<uint64_t> checkedPairs;
-    checkedPairs.reserve(2000);
+    for (CategoryBucket& bucket : categoryBuckets)
+    {
+        if (bucket.broadPhase)
+            bucket.broadPhase->BeginFrame();
+        bucket.rows.clear();
+    }
+    erasedSinceCollision.clear();
+    isErasedSorted = true;
 
-    broadPhaseGrid.Clear();
+    componentStore.SyncColliders(jobSystem);
+    const bool hasStaticChanged = componentStore.ConsumeStaticCollidersChanged();
 
-    for (Object* obj : rawPtrObjects)
+    const std::vector<ComponentBounds>& bounds = componentStore.GetColliderBounds();
+    std::array<uint32_t, CATEGORY_COUNT> categories{};
+    std::array<uint32_t, CATEGORY_COUNT> masks{};
+    dynamicColliderCount = 0;
+    size_t staticCount = 0;
+    colliderBoundsMin = glm::vec2(std::numeric_limits<float>::max());
+    colliderBoundsMax = glm::vec2(std::numeric_limits<float>::lowest());
+    for (uint32_t row = 0; row < componentStore.GetSize(); ++row)
     {
-        Collider* collider = obj->GetCollider();
-        if (collider)
-            broadPhaseGrid.Insert(obj);
+        if (!componentStore.colliders[row] || !(componentStore.flags[row] & ObjectComponentStore::ROW_ALIVE))
+            continue;
+        colliderBoundsMin = glm::min(colliderBoundsMin, bounds[row].min);
+        colliderBoundsMax = glm::max(colliderBoundsMax, bounds[row].max);
+        if (componentStore.flags[row] & ObjectComponentStore::ROW_STATIC_COLLIDER)
+        {
+            ++staticCount;
+            continue;
+        }
+
+        Object* obj = componentStore.owners[row];
+        const uint32_t category = obj->collisionCategory;
+        const uint32_t mask = obj->collisionMask;
+        //a pair needs each mask to hold the other's category, so an empty side rules out every pair
+        const size_t bucketIndex = (category == 0 || mask == 0) ? QUERY_ONLY_BUCKET : static_cast<size_t>(std::countr_zero(category));
+        if (bucketIndex != QUERY_ONLY_BUCKET)
+        {
+            categories[bucketIndex] |= category;
+            masks[bucketIndex] |= mask;
+        }
+
+        CategoryBucket& bucket = categoryBuckets[bucketIndex];
+        if (!bucket.broadPhase)
+            bucket.broadPhase = CreateBroadPhase(broadPhaseType);
+        bucket.rows.push_back(row);
+        bucket.broadPhase->Insert(obj, bounds[row].min, bounds[row].max);
+        ++dynamicColliderCount;
     }
 
-    broadPhaseGrid.ComputeCollisions([&](Object* a, Object* b)
+    bool hasCategoryChanged = false;
+    for (size_t i = 0; i < CATEGORY_COUNT; ++i)
+    {
+        CategoryBucket& bucket = categoryBuckets[i];
+        if (bucket.categories != categories[i] || bucket.masks != masks[i])
         {
-            if ((a->GetCollisionMask() & b->GetCollisionCategory()) == 0 ||
-                (b->GetCollisionMask() & a->GetCollisionCategory()) == 0)
-                return;
+            bucket.categories = categories[i];
+            bucket.masks = masks[i];
+            hasCategoryChanged = true;
+        }
+    }
+    if (hasCategoryChanged)
+        RebuildCategoryInteractions();
 
-            if (a > b) std::swap(a, b);
-            uint64_t key = std::hash<Object*>()(a) ^ (std::hash<Object*>()(b) << 1);
+    //a static collider that moved, changed or was added resyncs and raises the flag; one that left only changes the count
+    if (hasStaticChanged || staticCount != staticColliderCount)
+        RebuildStaticColliders();
 
-            if (checkedPairs.find(key) != checkedPairs.end())
-                return;
+    broadPhasePairs.clear();
+    for (size_t i = 0; i < categoryBuckets.size(); ++i)
+    {
+        BroadPhase* broadPhase = categoryBuckets[i].broadPhase.get();
+        if (!broadPhase)
+            continue;
+        //a bucket that never pairs with itself, such as a bullet swarm, is only built for the other buckets to probe
+        if (i != QUERY_ONLY_BUCKET && (categoryInteractions[i] >> i & 1u))
+            broadPhase->ComputePairs(broadPhasePairs);
+        else
+            broadPhase->Build();
+    }
 
-            checkedPairs.insert(key);
+    for (size_t i = 0; i < CATEGORY_COUNT; ++i)
+    {
+        //each unordered bucket pair once, from its lower index
+        uint32_t others = categoryInteractions[i] & ~((2u << i) - 1u);
+        while (others != 0)
+        {
+            AddCrossBucketPairs(i, static_cast<size_t>(std::countr_zero(others)));
+            others &= others - 1u;
+        }
+    }
+
+    if (staticColliderCount > 0)
+    {
+        for (size_t i = 0; i < CATEGORY_COUNT; ++i)
+        {
+            const CategoryBucket& bucket = categoryBuckets[i];
+            if ((bucket.masks & staticCategories) == 0 || (bucket.categories & staticMasks) == 0)
+                continue;
 
-            if (a->GetCollider()->CheckCollision(b->GetCollider()))
+            for (uint32_t row : bucket.rows)
             {
-                a->OnCollision(b);
-                b->OnCollision(a);
+                Object* obj = componentStore.owners[row];
+                if ((obj->collisionMask & staticCategories) == 0 || (obj->collisionCategory & staticMasks) == 0)
+                    continue;
+                staticColliderGrid.Query(bounds[row].min, bounds[row].max, [&](Object* other) { broadPhasePairs.emplace_back(obj, other); });
             }
+        }
+    }
+
+    const std::vector<ColliderShape>& shapes = componentStore.GetColliderShapes();
+    narrowPhase.Clear();
+    for (const auto& [a, b] : broadPhasePairs)
+    {
+        if ((a->GetCollisionMask() & b->GetCollisionCategory()) == 0 ||
+            (b->GetCollisionMask() & a->GetCollisionCategory()) == 0)
+            continue;
+
+        narrowPhase.Add(a, shapes[a->transform2D.row.index], b, shapes[b->transform2D.row.index]);
+    }
+
+    //every test runs on this frame's shapes before any callback can move or resize an object
+    contacts.clear();
+    narrowPhase.Run(contacts);
+
+    DispatchContacts();
+}
+
+void ObjectManager::DispatchContacts()
+{
+    currentContacts.clear();
+    for (auto [a, b] : contacts)
+    {
+        //only pairs that can raise enter belong in the cache, or a later exit would have no matching enter
+        if (!a->GetCollider() || !b->GetCollider())
+            continue;
+        if (b->handle.index < a->handle.index)
+            std::swap(a, b);
+        currentContacts.push_back({ (static_cast<uint64_t>(a->handle.index) << 32) | b->handle.index, a, b });
+    }
+
+    auto byKey = [](const ContactPair& lhs, const ContactPair& rhs) { return lhs.key < rhs.key; };
+    std::sort(currentContacts.begin(), currentContacts.end(), byKey);
+    currentContacts.erase(std::unique(currentContacts.begin(), currentContacts.end(),
+        [](const ContactPair& lhs, const ContactPair& rhs) { return lhs.key == rhs.key; }), currentContacts.end());
+
+    //both lists are sorted, so one merge walk tells new, persisting and ended contacts apart
+    size_t previous = 0;
+    size_t dispatched = 0;
+    for (const ContactPair& contact : currentContacts)
+    {
+        while (previous < contactCache.size() && contactCache[previous].key < contact.key)
+        {
+            DispatchExit(contactCache[previous].a, contactCache[previous].b);
+            ++previous;
+        }
+
+        const bool isStaying = previous < contactCache.size() && contactCache[previous].key == contact.key;
+        if (isStaying)
+            ++previous;
+
+        if (DispatchContact(contact.a, contact.b, isStaying))
+            currentContacts[dispatched++] = contact;
+        else if (isStaying)
+            DispatchExit(contact.a, contact.b);
+    }
+    for (; previous < contactCache.size(); ++previous)
+        DispatchExit(contactCache[previous].a, contactCache[previous].b);
+    currentContacts.resize(dispatched);
+
+    contactCache.swap(currentContacts);
+}
+
+bool ObjectManager::DispatchContact(Object* a, Object* b, bool isStaying)
+{
+    //an earlier callback may have dropped one of the colliders
+    if (!a->GetCollider() || !b->GetCollider())
+        return false;
+
+    a->WakeUp();
+    b->WakeUp();
+
+    const uint8_t event = isStaying ? COLLISION_EVENT_STAY : COLLISION_EVENT_ENTER;
+    for (auto [self, other] : { BroadPhasePair(a, b), BroadPhasePair(b, a) })
+    {
+        const uint8_t events = self->collisionEvents;
+        if (events & event)
+        {
+            if (isStaying)
+                self->OnCollisionStay(other);
+            else
+                self->OnCollisionEnter(other);
+        }
+        if (events & COLLISION_EVENT_OVERLAP)
+            self->OnCollision(other);
+    }
+    return true;
+}
+
+void ObjectManager::DispatchExit(Object* a, Object* b)
+{
+    if (a->collisionEvents & COLLISION_EVENT_EXIT)
+        a->OnCollisionExit(b);
+    if (b->collisionEvents & COLLISION_EVENT_EXIT)
+        b->OnCollisionExit(a);
+}
+
+void ObjectManager::DispatchExitsForDeadObjects()
+{
+    //runs before the dead are erased, while both pointers of every cached contact are still valid
+    auto removed = std::remove_if(contactCache.begin(), contactCache.end(), [this](const ContactPair& contact)
+        {
+            if (contact.a->IsAlive() && contact.b->IsAlive())
+                return false;
+            DispatchExit(contact.a, contact.b);
+            return true;
         });
+    contactCache.erase(removed, contactCache.end());
+}
+
+void ObjectManager::RebuildCategoryInteractions()
+{
+    for (size_t i = 0; i < CATEGORY_COUNT; ++i)
+    {
+        const CategoryBucket& a = categoryBuckets[i];
+        uint32_t interactions = 0;
+        for (size_t j = 0; j < CATEGORY_COUNT; ++j)
+        {
+            const CategoryBucket& b = categoryBuckets[j];
+            if ((a.masks & b.categories) != 0 && (b.masks & a.categories) != 0)
+                interactions |= 1u << j;
+        }
+        categoryInteractions[i] = interactions;
+    }
+}
+
+void ObjectManager::AddCrossBucketPairs(size_t bucketA, size_t bucketB)
+{
+    //the smaller bucket probes the larger one's broad phase
+    const CategoryBucket* probe = &categoryBuckets[bucketA];
+    const CategoryBucket* target = &categoryBuckets[bucketB];
+    if (probe->rows.size() > target->rows.size())
+        std::swap(probe, target);
+
+    const std::vector<ComponentBounds>& bounds = componentStore.GetColliderBounds();
+    for (uint32_t row : probe->rows)
+    {
+        Object* obj = componentStore.owners[row];
+        if ((obj->collisionMask & target->categories) == 0 || (obj->collisionCategory & target->masks) == 0)
+            continue;
+
+        crossBucketHits.clear();
+        target->broadPhase->QueryAABB(bounds[row].min, bounds[row].max, crossBucketHits);
+        for (Object* other : crossBucketHits)
+            broadPhasePairs.emplace_back(obj, other);
+    }
+}
+
+void ObjectManager::RebuildStaticColliders()
+{
+    staticColliderGrid.Clear();
+    staticColliderCount = 0;
+    staticCategories = 0;
+    staticMasks = 0;
+
+    const std::vector<ComponentBounds>& bounds = componentStore.GetColliderBounds();
+    for (uint32_t row = 0; row < componentStore.GetSize(); ++row)
+    {
+        const uint8_t flags = componentStore.flags[row];
+        if (!componentStore.colliders[row] || !(flags & ObjectComponentStore::ROW_ALIVE) || !(flags & ObjectComponentStore::ROW_STATIC_COLLIDER))
+            continue;
+        Object* obj = componentStore.owners[row];
+        staticColliderGrid.Insert(obj, bounds[row].min, bounds[row].max);
+        staticCategories |= obj->collisionCategory;
+        staticMasks |= obj->collisionMask;
+        ++staticColliderCount;
+    }
+    staticColliderGrid.Build();
+}
+
+size_t ObjectManager::QueryAABB(const glm::vec2& boundsMin, const glm::vec2& boundsMax, std::vector<Object*>& outObjects, uint32_t collisionMask)
+{
+    CollectQueryCandidates(boundsMin, boundsMax, collisionMask);
+
+    const size_t startSize = outObjects.size();
+    for (Object* obj : queryCandidates)
+        if (ShapeOverlapsAABB(GetColliderShape(obj), boundsMin, boundsMax))
+            outObjects.push_back(obj);
+    return outObjects.size() - startSize;
+}
+
+size_t ObjectManager::QueryCircle(const glm::vec2& center, float radius, std::vector<Object*>& outObjects, uint32_t collisionMask)
+{
+    CollectQueryCandidates(center - glm::vec2(radius), center + glm::vec2(radius), collisionMask);
+
+    const size_t startSize = outObjects.size();
+    for (Object* obj : queryCandidates)
+        if (DistanceToShape(GetColliderShape(obj), center) <= radius)
+            outObjects.push_back(obj);
+    return outObjects.size() - startSize;
+}
+
+size_t ObjectManager::QueryPoint(const glm::vec2& point, std::vector<Object*>& outObjects, uint32_t collisionMask)
+{
+    CollectQueryCandidates(point, point, collisionMask);
+
+    const size_t startSize = outObjects.size();
+    for (Object* obj : queryCandidates)
+        if (obj->GetCollider()->CheckPointCollision(point))
+            outObjects.push_back(obj);
+    return outObjects.size() - startSize;
+}
+
+bool ObjectManager::Raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, RaycastHit& outHit, uint32_t collisionMask)
+{
+    const float length = glm::length(direction);
+    if (length <= 0.f || maxDistance < 0.f)
+        return false;
+    const glm::vec2 normalized = direction / length;
+
+    const glm::vec2 end = origin + normalized * maxDistance;
+    CollectQueryCandidates(glm::min(origin, end), glm::max(origin, end), collisionMask);
+
+    bool hasHit = false;
+    float closest = maxDistance;
+    for (Object* obj : queryCandidates)
+    {
+        float distance;
+        glm::vec2 normal;
+        if (!RaycastShape(GetColliderShape(obj), origin, normalized, closest, distance, normal))
+            continue;
+
+        hasHit = true;
+        closest = distance;
+        outHit = { obj, origin + normalized * distance, normal, distance };
+    }
+    return hasHit;
+}
+
+size_t ObjectManager::FindNearest(const glm::vec2& point, size_t k, std::vector<Object*>& outObjects, uint32_t collisionMask, float maxDistance)
+{
+    if (k == 0 || maxDistance < 0.f || dynamicColliderCount + staticColliderCount == 0)
+        return 0;
+
+    //grow the search box until it holds k objects no farther than its half size, since anything closer
+    //than that must overlap the box; stop early once the box holds the bounds of every inserted collider
+    float radius = std::min(64.f, maxDistance);
+    while (true)
+    {
+        const glm::vec2 boxMin = point - glm::vec2(radius);
+        const glm::vec2 boxMax = point + glm::vec2(radius);
+        CollectQueryCandidates(boxMin, boxMax, collisionMask);
+
+        //a box holding everything already has every candidate, so its half size no longer limits the distance
+        const bool holdsAll = boxMin.x <= colliderBoundsMin.x && boxMin.y <= colliderBoundsMin.y &&
+            boxMax.x >= colliderBoundsMax.x && boxMax.y >= colliderBoundsMax.y;
+        const float distanceLimit = holdsAll ? maxDistance : radius;
+
+        nearestCandidates.clear();
+        for (Object* obj : queryCandidates)
+        {
+            const float distance = DistanceToShape(GetColliderShape(obj), point);
+            if (distance <= distanceLimit)
+                nearestCandidates.emplace_back(distance, obj);
+        }
+
+        if (nearestCandidates.size() >= k || radius >= maxDistance || holdsAll)
+            break;
+        radius = std::min(radius * 2.f, maxDistance);
+    }
+
+    const size_t count = std::min(k, nearestCandidates.size());
+    std::partial_sort(nearestCandidates.begin(), nearestCandidates.begin() + count, nearestCandidates.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    for (size_t i = 0; i < count; ++i)
+        outObjects.push_back(nearestCandidates[i].second);
+    return count;
+}
+
+uint32_t ObjectManager::MakeCollisionMask(const std::vector<std::string>& groups)
+{
+    uint32_t mask = 0;
+    for (const std::string& group : groups)
+        mask |= collisionGroupRegistry.GetGroupBit(group);
+    return mask;
+}
+
+void ObjectManager::CollectQueryCandidates(const glm::vec2& boundsMin, const glm::vec2& boundsMax, uint32_t collisionMask)
+{
+    queryCandidates.clear();
+    for (size_t i = 0; i < categoryBuckets.size(); ++i)
+    {
+        const CategoryBucket& bucket = categoryBuckets[i];
+        if (!bucket.broadPhase || (i != QUERY_ONLY_BUCKET && collisionMask != QUERY_ALL_CATEGORIES && (bucket.categories & collisionMask) == 0))
+            continue;
+        bucket.broadPhase->QueryAABB(boundsMin, boundsMax, queryCandidates);
+    }
+    staticColliderGrid.QueryAABB(boundsMin, boundsMax, queryCandidates);
+
+    if (!isErasedSorted)
+    {
+        std::sort(erasedSinceCollision.begin(), erasedSinceCollision.end());
+        isErasedSorted = true;
+    }
+
+    //anything may have died, lost its collider or been erased since the broad phase saw it
+    auto rejected = std::remove_if(queryCandidates.begin(), queryCandidates.end(), [this, collisionMask](const Object* obj)
+        {
+            if (std::binary_search(erasedSinceCollision.begin(), erasedSinceCollision.end(), obj))
+                return true;
+            if (!obj->IsAlive() || !obj->GetCollider() || obj->transform2D.row.store != &componentStore)
+                return true;
+            return collisionMask != QUERY_ALL_CATEGORIES && (obj->GetCollisionCategory() & collisionMask) == 0;
+        });
+    queryCandidates.erase(rejected, queryCandidates.end());
+}
+
+void ObjectManager::SetBroadPhase(BroadPhaseType type)
+{
+    if (broadPhaseType == type)
+        return;
+    broadPhaseType = type;
+    //the buckets are recreated with the new type on the next CheckCollision
+    for (CategoryBucket& bucket : categoryBuckets)
+        bucket.broadPhase.reset();
 }
 
 void ObjectManager::DrawColliderDebug(RenderManager* rm, Camera2D* cam)
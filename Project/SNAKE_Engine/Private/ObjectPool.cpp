@@ -0,0 +1,61 @@
+#include "Engine.h"
+
+Object* ObjectPoolBase::AcquireObject()
+{
+    if (parked.empty())
+    {
+        //an empty pool grows through the normal lifecycle; the new object is parked here once it dies
+        ObjectPtr obj = factory();
+        obj->ownerPool = this;
+        return objectManager->AddPooledObject(std::move(obj), tag, tagID);
+    }
+
+    ObjectPtr obj = std::move(parked.back());
+    parked.pop_back();
+    obj->isAlive = true;
+    obj->OnAcquire();
+    return objectManager->AddPooledObject(std::move(obj), tag, tagID);
+}
+
+void ObjectPoolBase::Prewarm(const EngineContext& engineContext, size_t count)
+{
+    std::vector<ObjectPtr> warmed;
+    warmed.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        ObjectPtr obj = factory();
+        obj->ownerPool = this;
+        warmed.push_back(std::move(obj));
+    }
+
+    for (auto& obj : warmed)
+        obj->Init(engineContext);
+
+    for (auto& obj : warmed)
+    {
+        obj->LateInit(engineContext);
+        obj->isPoolInitialized = true;
+        obj->isAlive = false;
+        parked.push_back(std::move(obj));
+    }
+}
+
+void ObjectPoolBase::Park(ObjectPtr obj)
+{
+    //a recycled object starts awake; binding it again puts it back in its update tier
+    obj->isAsleep = false;
+    ++obj->sleepGeneration;
+    obj->OnRelease();
+    parked.push_back(std::move(obj));
+}
+
+void ObjectPoolBase::FreeParked(const EngineContext& engineContext)
+{
+    for (const auto& obj : parked)
+        obj->Free(engineContext);
+
+    for (const auto& obj : parked)
+        obj->LateFree(engineContext);
+
+    parked.clear();
+}
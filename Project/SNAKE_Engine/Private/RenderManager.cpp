@@ -15,6 +15,34 @@ void RenderManager::Submit(const std::vector<Object*>& objects, const EngineCont
     }
 }
 
+void RenderManager::Submit(ObjectComponentStore& store, const EngineContext& engineContext)
+{
+    Camera2D* camera = engineContext.stateManager->GetCurrentState()->GetActiveCamera();
+    if (camera)
+    {
+        if (preparedStore != &store || preparedCamera != camera)
+        {
+            FrustumCuller::CullVisible(*camera, store, visibleRows, glm::vec2(camera->GetScreenWidth(), camera->GetScreenHeight()));
+            store.MarkVisible(visibleRows);
+        }
+        BuildRenderMap(store, visibleRows, camera);
+    }
+    preparedStore = nullptr;
+    preparedCamera = nullptr;
+}
+
+void RenderManager::PrepareSubmit(ObjectComponentStore& store, const EngineContext& engineContext)
+{
+    Camera2D* camera = engineContext.stateManager->GetCurrentState()->GetActiveCamera();
+    preparedStore = camera ? &store : nullptr;
+    preparedCamera = camera;
+    if (camera)
+    {
+        FrustumCuller::CullVisible(*camera, store, visibleRows, glm::vec2(camera->GetScreenWidth(), camera->GetScreenHeight()));
+        store.MarkVisible(visibleRows);
+    }
+}
+
 void FrustumCuller::CullVisible(const Camera2D& camera, const std::vector<Object*>& allObjects,
     std::vector<Object*>& outVisibleList, glm::vec2 viewportSize)
 {
@@ -36,6 +64,45 @@ void FrustumCuller::CullVisible(const Camera2D& camera, const std::vector<Object
     }
 }
 
+void FrustumCuller::CullVisible(const Camera2D& camera, const ObjectComponentStore& store,
+    std::vector<uint32_t>& outVisibleRows, glm::vec2 viewportSize)
+{
+    constexpr uint8_t requiredFlags = ObjectComponentStore::ROW_ALIVE | ObjectComponentStore::ROW_VISIBLE;
+
+    outVisibleRows.clear();
+    const uint32_t count = static_cast<uint32_t>(store.GetSize());
+    for (uint32_t row = 0; row < count; ++row)
+    {
+        const uint8_t flags = store.flags[row];
+        if ((flags & requiredFlags) != requiredFlags)
+            continue;
+        if (flags & ObjectComponentStore::ROW_IGNORE_CAMERA)
+        {
+            outVisibleRows.push_back(row);
+            continue;
+        }
+
+        glm::vec2 pos;
+        float radius;
+        if (flags & ObjectComponentStore::ROW_CUSTOM_BOUNDS)
+        {
+            const Object* obj = store.owners[row];
+            pos = obj->GetWorldPosition();
+            radius = obj->GetBoundingRadius();
+        }
+        else
+        {
+            const Mesh* mesh = store.meshes[row];
+            glm::vec2 halfSize = mesh ? mesh->GetLocalBoundsHalfSize() : glm::vec2(0.5f);
+            pos = store.positions[row];
+            radius = glm::length(halfSize * store.scales[row]);
+        }
+
+        if (camera.IsInView(pos, radius, viewportSize))
+            outVisibleRows.push_back(row);
+    }
+}
+
 void RenderManager::FlushDrawCommands(const EngineContext& engineContext)
 {
     Material* lastMaterial = nullptr;
@@ -49,7 +116,7 @@ void RenderManager::FlushDrawCommands(const EngineContext& engineContext)
         {
             for (const auto& [key, batch] : batchMap)
             {
-                if (batch.front().first->CanBeInstanced())
+                if (batch.front().object->CanBeInstanced())
                 {
                     std::vector<glm::mat4> transforms;
                     std::vector<glm::vec4> colors;
@@ -60,8 +127,23 @@ void RenderManager::FlushDrawCommands(const EngineContext& engineContext)
                     uvOffsets.reserve(batch.size());
                     uvScales.reserve(batch.size());
 
-                    for (const auto& [obj, camera] : batch)
+                    for (const RenderItem& item : batch)
                     {
+                        if (ObjectComponentStore* store = item.store)
+                        {
+                            //scaling by the flip vector only touches the first two columns
+                            glm::mat4 model = store->GetMatrix(item.row);
+                            const glm::vec2& flip = store->uvFlips[item.row];
+                            model[0] *= flip.x;
+                            model[1] *= flip.y;
+                            transforms.push_back(model);
+                            colors.push_back(store->colors[item.row]);
+                            uvOffsets.push_back(store->uvOffsets[item.row]);
+                            uvScales.push_back(store->uvScales[item.row]);
+                            continue;
+                        }
+
+                        Object* obj = item.object;
                         glm::mat4 model = obj->GetTransform2DMatrix();
                         glm::vec2 flip = obj->GetUVFlipVector();
                         model = model * glm::scale(glm::mat4(1.0f), glm::vec3(flip, 1.0f));
@@ -91,12 +173,12 @@ void RenderManager::FlushDrawCommands(const EngineContext& engineContext)
                         lastMaterial = material;
                     }
 
-                    Camera2D* cam = batch.front().second;
-                    bool ignoreCam = batch.front().first->ShouldIgnoreCamera();
+                    Camera2D* cam = batch.front().camera;
+                    bool ignoreCam = batch.front().object->ShouldIgnoreCamera();
 
                     if (!material->HasTexture())
                     {
-                        material->SetTexture("u_Texture", errorTexture);
+                        material->SetTexture("u_Texture"_sid, errorTexture);
                     }
 
                     glm::mat4 view = ignoreCam ? glm::mat4(1.0f)
@@ -109,15 +191,15 @@ void RenderManager::FlushDrawCommands(const EngineContext& engineContext)
                         -static_cast<float>(h) / 2.0f,
                         static_cast<float>(h) / 2.0f);
 
-                    material->SetUniform("u_View", view);
-                    material->SetUniform("u_Projection", projection);
+                    material->SetUniform("u_View"_sid, view);
+                    material->SetUniform("u_Projection"_sid, projection);
 
-                    if (batch.front().first->HasAnimation())
+                    if (batch.front().object->HasAnimation())
                     {
-                        material->SetTexture("u_Texture", batch.front().first->GetAnimator()->GetTexture());
+                        material->SetTexture("u_Texture"_sid, batch.front().object->GetAnimator()->GetTexture());
                     }
 
-                    batch.front().first->Draw(engineContext);
+                    batch.front().object->Draw(engineContext);
                     material->SendUniforms();
                     key.mesh->UpdateInstanceBuffer(transforms, colors, uvOffsets, uvScales);
                     key.mesh->DrawInstanced(static_cast<GLsizei>(transforms.size()));
@@ -125,8 +207,9 @@ void RenderManager::FlushDrawCommands(const EngineContext& engineContext)
 
                 else
                 {
-                    for (const auto& [obj, camera] : batch)
+                    for (const RenderItem& item : batch)
                     {
+                        Object* obj = item.object;
                         Material* material = key.material;
                         if (!material)
                             material = defaultMaterial;
@@ -139,11 +222,11 @@ void RenderManager::FlushDrawCommands(const EngineContext& engineContext)
                         }
 
                         bool ignoreCam = obj->ShouldIgnoreCamera();
-                        Camera2D* cam = camera;
+                        Camera2D* cam = item.camera;
 
                         if (!material->HasTexture())
                         {
-                            material->SetTexture("u_Texture", errorTexture);
+                            material->SetTexture("u_Texture"_sid, errorTexture);
                         }
 
                         glm::mat4 view = ignoreCam ? glm::mat4(1.0f)
@@ -156,22 +239,22 @@ void RenderManager::FlushDrawCommands(const EngineContext& engineContext)
                             -static_cast<float>(h) / 2.0f,
                             static_cast<float>(h) / 2.0f);
 
-                        material->SetUniform("u_View", view);
-                        material->SetUniform("u_Projection", projection);
+                        material->SetUniform("u_View"_sid, view);
+                        material->SetUniform("u_Projection"_sid, projection);
 
                         glm::mat4 model = obj->GetTransform2DMatrix();
                         glm::vec2 flip = obj->GetUVFlipVector();
                         model = model * glm::scale(glm::mat4(1.0f), glm::vec3(flip, 1.0f));
 
-                        material->SetUniform("u_Model", model);
-                        material->SetUniform("u_Color", obj->GetColor());
+                        material->SetUniform("u_Model"_sid, model);
+                        material->SetUniform("u_Color"_sid, obj->GetColor());
 
                         if (obj->HasAnimation())
                         {
                             SpriteAnimator* anim = obj->GetAnimator();
-                            material->SetUniform("u_UVOffset", anim->GetUVOffset());
-                            material->SetUniform("u_UVScale", anim->GetUVScale());
-                            material->SetTexture("u_Texture", anim->GetTexture());
+                            material->SetUniform("u_UVOffset"_sid, anim->GetUVOffset());
+                            material->SetUniform("u_UVScale"_sid, anim->GetUVScale());
+                            material->SetTexture("u_Texture"_sid, anim->GetTexture());
                         }
 
                         obj->Draw(engineContext);
@@ -190,6 +273,8 @@ void RenderManager::FlushDrawCommands(const EngineContext& engineContext)
     {
         shdrMap.clear();
     }
+    preparedStore = nullptr;
+    preparedCamera = nullptr;
 }
 
 void RenderManager::SetViewport(int x, int y, int width, int height)
@@ -230,8 +315,8 @@ void RenderManager::FlushDebugLineDrawCommands(const EngineContext& engineContex
             static_cast<float>(engineContext.windowManager->GetHeight()) / 2
         );
 
-        debugLineShader->SendUniform("u_View", view);
-        debugLineShader->SendUniform("u_Projection", proj);
+        debugLineShader->SendUniform("u_View"_sid, view);
+        debugLineShader->SendUniform("u_Projection"_sid, proj);
 
         std::vector<float> vertexData;
         vertexData.reserve(lines.size() * 12);
@@ -263,8 +348,42 @@ RenderLayerManager& RenderManager::GetRenderLayerManager()
     return renderLayerManager;
 }
 
+void RenderManager::UploadPendingGlyphs()
+{
+    glyphRasterizer.CollectResults(rasterizedGlyphs);
+    if (rasterizedGlyphs.empty())
+        return;
+
+    std::vector<Font*> updatedFonts;
+    for (const RasterizedGlyph& glyph : rasterizedGlyphs)
+    {
+        glyph.font->CommitGlyph(glyph);
+        if (std::find(updatedFonts.begin(), updatedFonts.end(), glyph.font) == updatedFonts.end())
+            updatedFonts.push_back(glyph.font);
+    }
+
+    for (Font* font : updatedFonts)
+        font->glyphVersion++;
+
+    rasterizedGlyphs.clear();
+}
+
+MeshArena& RenderManager::GetMeshArena(const VertexLayout& layout)
+{
+    //one arena per vertex format, since a VAO can only describe a single layout
+    std::unique_ptr<MeshArena>& arena = meshArenas[layout];
+    if (!arena)
+    {
+        arena = std::make_unique<MeshArena>(layout);
+        arena->Init();
+    }
+    return *arena;
+}
+
 void RenderManager::Init(const EngineContext& engineContext)
 {
+    glyphRasterizer.Init();
+
     auto shader = std::make_unique<Shader>();
 
     shader->AttachFromSource(ShaderStage::Vertex, R"(
@@ -300,7 +419,8 @@ void RenderManager::Init(const EngineContext& engineContext)
     )");
 
     shader->Link();
-    shaderMap["[EngineShader]internal_text"] = std::move(shader);
+    shaderMap[StringID::Intern("[EngineShader]internal_text")] = std::move(shader);
+    glyphAtlas.Init(*this);
 
     shader = std::make_unique<Shader>();
     shader->AttachFromSource(ShaderStage::Vertex, R"(
@@ -330,7 +450,7 @@ void RenderManager::Init(const EngineContext& engineContext)
     )");
     shader->Link();
 
-    shaderMap["[EngineShader]internal_debug_line"] = std::move(shader);
+    shaderMap[StringID::Intern("[EngineShader]internal_debug_line")] = std::move(shader);
     debugLineShader = GetShaderByTag("[EngineShader]internal_debug_line");
 
 
@@ -364,7 +484,7 @@ void RenderManager::Init(const EngineContext& engineContext)
     )");
     shader->Link();
 
-    shaderMap["[EngineShader]default"] = std::move(shader);
+    shaderMap[StringID::Intern("[EngineShader]default")] = std::move(shader);
 
 
     std::vector<unsigned char> errorTexturePixels;
@@ -425,7 +545,7 @@ void RenderManager::Init(const EngineContext& engineContext)
     )");
     shader->Link();
 
-    shaderMap["[EngineShader]default_texture"] = std::move(shader);
+    shaderMap[StringID::Intern("[EngineShader]default_texture")] = std::move(shader);
     std::unique_ptr<Material> material = std::make_unique<Material>(GetShaderByTag("[EngineShader]default_texture"));
     material->SetTexture("u_ErrorTexture", errorTexture);
     RegisterMaterial("[EngineMaterial]error", std::move(material));
@@ -436,7 +556,7 @@ void RenderManager::Init(const EngineContext& engineContext)
         { { 0.5f, -0.5f, 0.f }, { 1.f, 0.f } },
         { { 0.5f, 0.5f, 0.f }, { 1.f, 1.f } },
         { { -0.5f, 0.5f, 0.f }, { 0.f, 1.f } }
-    }, std::vector<unsigned int>{0, 1, 2, 2, 3, 0});
+    }, std::vector<unsigned int>{0, 1, 2, 2, 3, 0}, PrimitiveType::Triangles, { VertexPositionFormat::Float2, VertexUVFormat::UNorm16x2 });
     defaultMesh = GetMeshByTag("[EngineMesh]default");
 
     RegisterSpriteSheet("[EngineSpriteSheet]default", "[EngineTexture]error", 1, 1);
@@ -479,7 +599,7 @@ void RenderManager::BuildRenderMap(const std::vector<Object*>& source, Camera2D*
         if (!material || !mesh || !shader)
             continue;
 
-        uint8_t layer = renderLayerManager.GetLayerID(obj->GetRenderLayerTag()).value_or(0);
+        uint8_t layer = renderLayerManager.GetLayerID(obj->GetRenderLayerTagID()).value_or(0);
         if (layer >= RenderLayerManager::MAX_LAYERS)
         {
             SNAKE_WRN("render skipped - invalid layer\n");
@@ -487,7 +607,40 @@ void RenderManager::BuildRenderMap(const std::vector<Object*>& source, Camera2D*
         }
 
         InstanceBatchKey key{ mesh, material, spritesheet };
-        renderMap[layer][shader][key].emplace_back(obj, camera);
+        renderMap[layer][shader][key].push_back({ obj, camera });
+    }
+}
+
+void RenderManager::BuildRenderMap(ObjectComponentStore& store, const std::vector<uint32_t>& rows, Camera2D* camera)
+{
+    if (store.renderLayerVersion != renderLayerManager.GetVersion())
+    {
+        std::fill(store.renderLayers.begin(), store.renderLayers.end(), ObjectComponentStore::UNRESOLVED_LAYER);
+        store.renderLayerVersion = renderLayerManager.GetVersion();
+    }
+
+    for (uint32_t row : rows)
+    {
+        Material* material = store.materials[row];
+        Mesh* mesh = store.meshes[row];
+        Shader* shader = material ? material->GetShader() : nullptr;
+
+        if (!mesh || !shader)
+            continue;
+
+        //layer ids are resolved once per row rather than looked up every frame
+        uint8_t& layer = store.renderLayers[row];
+        if (layer == ObjectComponentStore::UNRESOLVED_LAYER)
+            layer = renderLayerManager.GetLayerID(store.owners[row]->GetRenderLayerTagID()).value_or(0);
+        if (layer >= RenderLayerManager::MAX_LAYERS)
+        {
+            SNAKE_WRN("render skipped - invalid layer\n");
+            continue;
+        }
+
+        SpriteAnimator* spriteAnimator = store.animators[row];
+        InstanceBatchKey key{ mesh, material, spriteAnimator ? spriteAnimator->GetSpriteSheet() : nullptr };
+        renderMap[layer][shader][key].push_back({ store.owners[row], camera, &store, row });
     }
 }
 
@@ -501,7 +654,7 @@ void RenderManager::BuildRenderMap(const std::vector<Object*>& source, Camera2D*
  */
 void RenderManager::RegisterShader(const std::string& tag, const std::vector<std::pair<ShaderStage, FilePath>>& sources)
 {
-    if (shaderMap.find(tag) != shaderMap.end())
+    if (shaderMap.find(StringID(tag)) != shaderMap.end())
     {
         SNAKE_LOG("Shader with tag \"" << tag << "\" already registered.");
         return;
@@ -522,70 +675,72 @@ void RenderManager::RegisterShader(const std::string& tag, const std::vector<std
         SNAKE_ERR("Failed to register shader [" << tag << "].");
         return;
     }
-    shaderMap[tag] = std::move(shader);
+    shaderMap[StringID::Intern(tag)] = std::move(shader);
 }
 
 void RenderManager::RegisterShader(const std::string& tag, std::unique_ptr<Shader> shader)
 {
-    if (shaderMap.find(tag) != shaderMap.end())
+    if (shaderMap.find(StringID(tag)) != shaderMap.end())
     {
         SNAKE_LOG("Shader with tag \"" << tag << "\" already registered.");
         return;
     }
-    shaderMap[tag] = std::move(shader);
+    shaderMap[StringID::Intern(tag)] = std::move(shader);
 }
 
 void RenderManager::RegisterTexture(const std::string& tag, const FilePath& path, const TextureSettings& settings)
 {
-    if (textureMap.find(tag) != textureMap.end())
+    if (textureMap.find(StringID(tag)) != textureMap.end())
     {
         SNAKE_LOG("Texture with tag \"" << tag << "\" already registered.");
         return;
     }
-    textureMap[tag] = std::make_unique<Texture>(path, settings);
+    textureMap[StringID::Intern(tag)] = std::make_unique<Texture>(path, settings);
 }
 
 void RenderManager::RegisterTexture(const std::string& tag, std::unique_ptr<Texture> texture)
 {
-    if (textureMap.find(tag) != textureMap.end())
+    if (textureMap.find(StringID(tag)) != textureMap.end())
     {
         SNAKE_LOG("Texture with tag \"" << tag << "\" already registered.");
         return;
     }
-    textureMap[tag] = std::move(texture);
+    textureMap[StringID::Intern(tag)] = std::move(texture);
 }
 
 void RenderManager::RegisterMesh(const std::string& tag, const std::vector<Vertex>& vertices,
-    const std::vector<unsigned int>& indices, PrimitiveType primitiveType)
+    const std::vector<unsigned int>& indices, PrimitiveType primitiveType, const VertexLayout& layout)
 {
-    if (meshMap.find(tag) != meshMap.end())
+    if (meshMap.find(StringID(tag)) != meshMap.end())
     {
         SNAKE_LOG("Mesh with tag \"" << tag << "\" already registered.");
         return;
     }
-    meshMap[tag] = std::make_unique<Mesh>(vertices, indices, primitiveType);
+    //registered meshes share the arena's buffers so switching between them does not rebind vertex state
+    meshMap[StringID::Intern(tag)] = std::unique_ptr<Mesh>(new Mesh(GetMeshArena(layout), vertices, indices, primitiveType));
 }
 
 void RenderManager::RegisterMesh(const std::string& tag, std::unique_ptr<Mesh> mesh)
 {
-    if (meshMap.find(tag) != meshMap.end())
+    if (meshMap.find(StringID(tag)) != meshMap.end())
     {
         SNAKE_LOG("Mesh with tag \"" << tag << "\" already registered.");
         return;
     }
-    meshMap[tag] = std::move(mesh);
+    meshMap[StringID::Intern(tag)] = std::move(mesh);
 }
 
 void RenderManager::RegisterMaterial(const std::string& tag, const std::string& shaderTag,
     const std::unordered_map<UniformName, TextureTag>& textureBindings)
 {
-    if (materialMap.find(tag) != materialMap.end())
+    if (materialMap.find(StringID(tag)) != materialMap.end())
     {
         SNAKE_LOG("Material tag already registered: " << tag);
         return;
     }
 
-    Shader* shader = shaderMap[shaderTag].get();
+    auto shaderIt = shaderMap.find(StringID(shaderTag));
+    Shader* shader = shaderIt != shaderMap.end() ? shaderIt->second.get() : nullptr;
     if (!shader)
     {
         SNAKE_WRN("Shader not found: " << shaderTag);
@@ -596,29 +751,29 @@ void RenderManager::RegisterMaterial(const std::string& tag, const std::string&
 
     for (const auto& [uniformName, textureTag] : textureBindings)
     {
-        auto it = textureMap.find(textureTag);
+        auto it = textureMap.find(StringID(textureTag));
         if (it != textureMap.end())
             material->SetTexture(uniformName, it->second.get());
         else
             SNAKE_WRN("Texture not found: " << textureTag);
     }
 
-    materialMap[tag] = std::move(material);
+    materialMap[StringID::Intern(tag)] = std::move(material);
 }
 
 void RenderManager::RegisterMaterial(const std::string& tag, std::unique_ptr<Material> material)
 {
-    if (materialMap.find(tag) != materialMap.end())
+    if (materialMap.find(StringID(tag)) != materialMap.end())
     {
         SNAKE_LOG("Material tag already registered: " << tag);
         return;
     }
-    materialMap[tag] = std::move(material);
+    materialMap[StringID::Intern(tag)] = std::move(material);
 }
 
 void RenderManager::RegisterFont(const std::string& tag, const std::string& ttfPath, uint32_t pixelSize)
 {
-    if (fontMap.find(tag) != fontMap.end())
+    if (fontMap.find(StringID(tag)) != fontMap.end())
     {
         SNAKE_LOG("Font tag already registered: " << tag);
         return;
@@ -634,17 +789,17 @@ void RenderManager::RegisterFont(const std::string& tag, const std::string& ttfP
 
     auto font = std::make_unique<Font>(*this, ttfPath, pixelSize);
 
-    fontMap[tag] = std::move(font);
+    fontMap[StringID::Intern(tag)] = std::move(font);
 }
 
 void RenderManager::RegisterFont(const std::string& tag, std::unique_ptr<Font> font)
 {
-    if (fontMap.find(tag) != fontMap.end())
+    if (fontMap.find(StringID(tag)) != fontMap.end())
     {
         SNAKE_LOG("Font tag already registered: " << tag);
         return;
     }
-    fontMap[tag] = std::move(font);
+    fontMap[StringID::Intern(tag)] = std::move(font);
 }
 
 void RenderManager::RegisterRenderLayer(const std::string& tag, uint8_t layer)
@@ -654,7 +809,7 @@ void RenderManager::RegisterRenderLayer(const std::string& tag, uint8_t layer)
 
 void RenderManager::RegisterSpriteSheet(const std::string& tag, const std::string& textureTag, int frameW, int frameH)
 {
-    if (spritesheetMap.find(tag) != spritesheetMap.end())
+    if (spritesheetMap.find(StringID(tag)) != spritesheetMap.end())
     {
         SNAKE_LOG("SpriteSheet already registered: " << tag);
         return;
@@ -667,12 +822,12 @@ void RenderManager::RegisterSpriteSheet(const std::string& tag, const std::strin
         return;
     }
 
-    spritesheetMap[tag] = std::make_unique<SpriteSheet>(texture, frameW, frameH);
+    spritesheetMap[StringID::Intern(tag)] = std::make_unique<SpriteSheet>(texture, frameW, frameH);
 }
 
 void RenderManager::UnregisterShader(const std::string& tag, const EngineContext& engineContext)
 {
-    auto it = shaderMap.find(tag);
+    auto it = shaderMap.find(StringID(tag));
     if (it == shaderMap.end())
     {
         SNAKE_LOG("Cannot delete the shader [" << tag << "] because it was not found.");
@@ -682,7 +837,7 @@ void RenderManager::UnregisterShader(const std::string& tag, const EngineContext
     GameState* gameState = engineContext.stateManager->GetCurrentState();
     if (gameState)
     {
-        std::vector<Object*> objects = gameState->GetObjectManager().GetAllRawPtrObjects();
+        const std::vector<Object*>& objects = gameState->GetObjectManager().GetAllRawPtrObjects();
         for (auto obj : objects)
         {
             Material* material = obj->GetMaterial();
@@ -692,13 +847,13 @@ void RenderManager::UnregisterShader(const std::string& tag, const EngineContext
                 return;
             }
         }
-        shaderMap.erase(tag);
+        shaderMap.erase(it);
     }
 }
 
 void RenderManager::UnregisterTexture(const std::string& tag, const EngineContext& engineContext)
 {
-    auto it = textureMap.find(tag);
+    auto it = textureMap.find(StringID(tag));
     if (it == textureMap.end())
     {
         SNAKE_LOG("Cannot delete the texture [" << tag << "] because it was not found.");
@@ -708,7 +863,7 @@ void RenderManager::UnregisterTexture(const std::string& tag, const EngineContex
     GameState* gameState = engineContext.stateManager->GetCurrentState();
     if (gameState)
     {
-        std::vector<Object*> objects = gameState->GetObjectManager().GetAllRawPtrObjects();
+        const std::vector<Object*>& objects = gameState->GetObjectManager().GetAllRawPtrObjects();
         for (auto obj : objects)
         {
             Material* material = obj->GetMaterial();
@@ -732,13 +887,13 @@ void RenderManager::UnregisterTexture(const std::string& tag, const EngineContex
                 }
             }
         }
-        textureMap.erase(tag);
+        textureMap.erase(it);
     }
 }
 
 void RenderManager::UnregisterMesh(const std::string& tag, const EngineContext& engineContext)
 {
-    auto it = meshMap.find(tag);
+    auto it = meshMap.find(StringID(tag));
     if (it == meshMap.end())
     {
         SNAKE_LOG("Cannot delete the mesh [" << tag << "] because it was not found.");
@@ -748,7 +903,7 @@ void RenderManager::UnregisterMesh(const std::string& tag, const EngineContext&
     GameState* gameState = engineContext.stateManager->GetCurrentState();
     if (gameState)
     {
-        std::vector<Object*> objects = gameState->GetObjectManager().GetAllRawPtrObjects();
+        const std::vector<Object*>& objects = gameState->GetObjectManager().GetAllRawPtrObjects();
         for (auto obj : objects)
         {
             if (obj->GetMesh() == target)
@@ -757,13 +912,13 @@ void RenderManager::UnregisterMesh(const std::string& tag, const EngineContext&
                 return;
             }
         }
-        meshMap.erase(tag);
+        meshMap.erase(it);
     }
 }
 
 void RenderManager::UnregisterMaterial(const std::string& tag, const EngineContext& engineContext)
 {
-    auto it = materialMap.find(tag);
+    auto it = materialMap.find(StringID(tag));
     if (it == materialMap.end())
     {
         SNAKE_LOG("Cannot delete the material [" << tag << "] because it was not found.");
@@ -773,7 +928,7 @@ void RenderManager::UnregisterMaterial(const std::string& tag, const EngineConte
     GameState* gameState = engineContext.stateManager->GetCurrentState();
     if (gameState)
     {
-        std::vector<Object*> objects = gameState->GetObjectManager().GetAllRawPtrObjects();
+        const std::vector<Object*>& objects = gameState->GetObjectManager().GetAllRawPtrObjects();
         for (auto obj : objects)
         {
             if (obj->GetMaterial() == target)
@@ -782,13 +937,13 @@ void RenderManager::UnregisterMaterial(const std::string& tag, const EngineConte
                 return;
             }
         }
-        materialMap.erase(tag);
+        materialMap.erase(it);
     }
 }
 
 void RenderManager::UnregisterFont(const std::string& tag, const EngineContext& engineContext)
 {
-    auto it = fontMap.find(tag);
+    auto it = fontMap.find(StringID(tag));
     if (it == fontMap.end())
     {
         SNAKE_LOG("Cannot delete the font [" << tag << "] because it was not found.");
@@ -798,7 +953,7 @@ void RenderManager::UnregisterFont(const std::string& tag, const EngineContext&
     GameState* gameState = engineContext.stateManager->GetCurrentState();
     if (gameState)
     {
-        std::vector<Object*> objects = gameState->GetObjectManager().GetAllRawPtrObjects();
+        const std::vector<Object*>& objects = gameState->GetObjectManager().GetAllRawPtrObjects();
         for (auto obj : objects)
         {
             if (obj->GetType() == ObjectType::TEXT && dynamic_cast<TextObject*>(obj)->GetTextInstance()->font == target)
@@ -807,7 +962,7 @@ void RenderManager::UnregisterFont(const std::string& tag, const EngineContext&
                 return;
             }
         }
-        fontMap.erase(tag);
+        fontMap.erase(it);
     }
 }
 
@@ -818,7 +973,7 @@ void RenderManager::UnregisterRenderLayer(const std::string& tag)
 
 void RenderManager::UnregisterSpriteSheet(const std::string& tag, const EngineContext& engineContext)
 {
-    auto it = spritesheetMap.find(tag);
+    auto it = spritesheetMap.find(StringID(tag));
     if (it == spritesheetMap.end())
     {
         SNAKE_LOG("Cannot delete the sprite sheet [" << tag << "] because it was not found.");
@@ -828,7 +983,7 @@ void RenderManager::UnregisterSpriteSheet(const std::string& tag, const EngineCo
     GameState* gameState = engineContext.stateManager->GetCurrentState();
     if (gameState)
     {
-        std::vector<Object*> objects = gameState->GetObjectManager().GetAllRawPtrObjects();
+        const std::vector<Object*>& objects = gameState->GetObjectManager().GetAllRawPtrObjects();
         for (auto obj : objects)
         {
             SpriteAnimator* spriteAnim = obj->GetSpriteAnimator();
@@ -838,78 +993,108 @@ void RenderManager::UnregisterSpriteSheet(const std::string& tag, const EngineCo
                 return;
             }
         }
-        spritesheetMap.erase(tag);
+        spritesheetMap.erase(it);
     }
 }
 
 SpriteSheet* RenderManager::GetSpriteSheetByTag(const std::string& tag)
+{
+    return GetSpriteSheetByTag(StringID(tag));
+}
+
+SpriteSheet* RenderManager::GetSpriteSheetByTag(StringID tag)
 {
     auto it = spritesheetMap.find(tag);
     if (it != spritesheetMap.end())
         return it->second.get();
     else
     {
-        SNAKE_ERR("There is no SpriteSheet named '" << tag << "'");
+        SNAKE_ERR("There is no SpriteSheet named '" << tag.GetString() << "'");
         return defaultSpriteSheet;
     }
 }
 
 Shader* RenderManager::GetShaderByTag(const std::string& tag)
+{
+    return GetShaderByTag(StringID(tag));
+}
+
+Shader* RenderManager::GetShaderByTag(StringID tag)
 {
     auto it = shaderMap.find(tag);
     if (it != shaderMap.end())
         return it->second.get();
     else
     {
-        SNAKE_ERR("There is no Shader named '" << tag << "'");
+        SNAKE_ERR("There is no Shader named '" << tag.GetString() << "'");
         return defaultShader;
     }
 }
 
 Texture* RenderManager::GetTextureByTag(const std::string& tag)
+{
+    return GetTextureByTag(StringID(tag));
+}
+
+Texture* RenderManager::GetTextureByTag(StringID tag)
 {
     auto it = textureMap.find(tag);
     if (it != textureMap.end())
         return it->second.get();
     else
     {
-        SNAKE_ERR("There is no Texture named '" << tag << "'");
+        SNAKE_ERR("There is no Texture named '" << tag.GetString() << "'");
         return errorTexture;
     }
 }
 
 Mesh* RenderManager::GetMeshByTag(const std::string& tag)
+{
+    return GetMeshByTag(StringID(tag));
+}
+
+Mesh* RenderManager::GetMeshByTag(StringID tag)
 {
     auto it = meshMap.find(tag);
     if (it != meshMap.end())
         return it->second.get();
     else
     {
-        SNAKE_ERR("There is no Mesh named '" << tag << "'");
+        SNAKE_ERR("There is no Mesh named '" << tag.GetString() << "'");
         return defaultMesh;
     }
 }
 
 Material* RenderManager::GetMaterialByTag(const std::string& tag)
+{
+    return GetMaterialByTag(StringID(tag));
+}
+
+Material* RenderManager::GetMaterialByTag(StringID tag)
 {
     auto it = materialMap.find(tag);
     if (it != materialMap.end())
         return it->second.get();
     else
     {
-        SNAKE_ERR("There is no Material named '" << tag << "'");
+        SNAKE_ERR("There is no Material named '" << tag.GetString() << "'");
         return defaultMaterial;
     }
 }
 
 Font* RenderManager::GetFontByTag(const std::string& tag)
+{
+    return GetFontByTag(StringID(tag));
+}
+
+Font* RenderManager::GetFontByTag(StringID tag)
 {
     auto it = fontMap.find(tag);
     if (it != fontMap.end())
         return it->second.get();
     else
     {
-        SNAKE_ERR("There is no Font named '" << tag << "'");
+        SNAKE_ERR("There is no Font named '" << tag.GetString() << "'");
         return nullptr;
     }
 }
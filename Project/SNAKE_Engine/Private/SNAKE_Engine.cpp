@@ -14,6 +14,7 @@ void SNAKE_Engine::SetEngineContext()
     engineContext.inputManager = &inputManager;
     engineContext.renderManager = &renderManager;
     engineContext.soundManager = &soundManager;
+    engineContext.jobSystem = &jobSystem;
     engineContext.engine = this;
 }
 
@@ -26,13 +27,29 @@ bool SNAKE_Engine::Init(int windowWidth, int windowHeight)
         return false;
     }
     SetEngineContext();
+    jobSystem.Init();
     inputManager.Init(windowManager.GetHandle());
     soundManager.Init();
     renderManager.Init(engineContext);
+    BuildFrameTaskGraph();
 
     return true;
 }
 
+void SNAKE_Engine::BuildFrameTaskGraph()
+{
+    frameTaskGraph.Clear();
+
+    FrameStageID update = frameTaskGraph.AddStage("Update", [this]() { stateManager.Update(frameDeltaTime, engineContext); });
+    FrameStageID collision = frameTaskGraph.AddStage("Collision", [this]() { stateManager.CheckCollision(engineContext); }, { update });
+    FrameStageID lateUpdate = frameTaskGraph.AddStage("LateUpdate", [this]() { stateManager.LateUpdate(frameDeltaTime, engineContext); }, { collision });
+
+    //game code is done touching objects here, so culling overlaps with sound cleanup; sound stays on the main thread since draw code may play sounds
+    FrameStageID cull = frameTaskGraph.AddStage("Cull", [this]() { stateManager.PrepareDraw(engineContext); }, { lateUpdate }, false);
+    frameTaskGraph.AddStage("Sound", [this]() { soundManager.Update(); }, { lateUpdate });
+    frameTaskGraph.AddStage("Draw", [this]() { stateManager.Draw(engineContext); }, { cull });
+}
+
 
 void SNAKE_Engine::Run()
 {
@@ -50,18 +67,19 @@ void SNAKE_Engine::Run()
 
         windowManager.PollEvents();
         inputManager.Update();
+        renderManager.UploadPendingGlyphs();
+        jobSystem.ExecuteMainThreadJobs();
         windowManager.ClearScreen();
 
-        stateManager.Update(dt, engineContext);
-        stateManager.Draw(engineContext);
-
-        soundManager.Update();
+        frameDeltaTime = dt;
+        frameTaskGraph.Run(jobSystem);
 
         windowManager.SwapBuffers();
     }
 
     soundManager.Free();
     stateManager.Free(engineContext);
+    jobSystem.Shutdown();
     windowManager.Free();
     Free();
 }
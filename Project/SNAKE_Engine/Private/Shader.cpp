@@ -1,5 +1,6 @@
 #include "Engine.h"
 
+#include <algorithm>
 #include <iosfwd>
 #include <sstream>
 #include <fstream>
@@ -124,6 +125,7 @@ bool Shader::Link()
     }
 
     CheckSupportsInstancing();
+    CacheUniformLocations();
 
     for (GLuint shader : attachedShaders)
     {
@@ -144,72 +146,114 @@ void Shader::Unuse() const
 
 void Shader::SendUniform(const std::string& name, int value) const
 {
-    GLint location = glGetUniformLocation(programID, name.c_str());
-    if (location == -1)
-    {
-        SNAKE_LOG("[Shader] Uniform not found: " << name);
-        return;
-    }
-    glUniform1i(location, value);
+    SendUniform(StringID(name), value);
 }
 
 void Shader::SendUniform(const std::string& name, float value) const
 {
-    GLint location = glGetUniformLocation(programID, name.c_str());
-    if (location == -1)
-    {
-        SNAKE_LOG("[Shader] Uniform not found: " << name);
-        return;
-    }
-    glUniform1f(location, value);
+    SendUniform(StringID(name), value);
 }
 
 void Shader::SendUniform(const std::string& name, const glm::vec2& value) const
 {
-    GLint location = glGetUniformLocation(programID, name.c_str());
-    if (location == -1)
-    {
-        SNAKE_LOG("Uniform not found: " << name);
-        return;
-    }
-
-    glUniform2fv(location, 1, &value[0]);
+    SendUniform(StringID(name), value);
 }
 
 void Shader::SendUniform(const std::string& name, const glm::vec3& value) const
 {
-    GLint location = glGetUniformLocation(programID, name.c_str());
-    if (location == -1)
-    {
-        SNAKE_LOG("Uniform not found: " << name);
-        return;
-    }
-
-    glUniform3fv(location, 1, &value[0]);
+    SendUniform(StringID(name), value);
 }
 
 void Shader::SendUniform(const std::string& name, const glm::vec4& value) const
 {
-    GLint location = glGetUniformLocation(programID, name.c_str());
-    if (location == -1)
-    {
-        SNAKE_LOG("Uniform not found: " << name);
-        return;
-    }
-
-    glUniform4fv(location, 1, &value[0]);
+    SendUniform(StringID(name), value);
 }
 
 void Shader::SendUniform(const std::string& name, const glm::mat4& value) const
 {
-    GLint location = glGetUniformLocation(programID, name.c_str());
-    if (location == -1)
+    SendUniform(StringID(name), value);
+}
+
+void Shader::SendUniform(StringID name, int value) const
+{
+    GLint location = GetUniformLocation(name);
+    if (location != -1)
+        glUniform1i(location, value);
+}
+
+void Shader::SendUniform(StringID name, float value) const
+{
+    GLint location = GetUniformLocation(name);
+    if (location != -1)
+        glUniform1f(location, value);
+}
+
+void Shader::SendUniform(StringID name, const glm::vec2& value) const
+{
+    GLint location = GetUniformLocation(name);
+    if (location != -1)
+        glUniform2fv(location, 1, &value[0]);
+}
+
+void Shader::SendUniform(StringID name, const glm::vec3& value) const
+{
+    GLint location = GetUniformLocation(name);
+    if (location != -1)
+        glUniform3fv(location, 1, &value[0]);
+}
+
+void Shader::SendUniform(StringID name, const glm::vec4& value) const
+{
+    GLint location = GetUniformLocation(name);
+    if (location != -1)
+        glUniform4fv(location, 1, &value[0]);
+}
+
+void Shader::SendUniform(StringID name, const glm::mat4& value) const
+{
+    GLint location = GetUniformLocation(name);
+    if (location != -1)
+        glUniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]);
+}
+
+GLint Shader::GetUniformLocation(StringID name) const
+{
+    auto it = uniformLocations.find(name);
+    if (it != uniformLocations.end())
+        return it->second;
+
+    SNAKE_LOG("[Shader] Uniform not found: " << name.GetString());
+    return -1;
+}
+
+void Shader::CacheUniformLocations()
+{
+    uniformLocations.clear();
+
+    GLint uniformCount = 0;
+    GLint maxNameLength = 0;
+    glGetProgramiv(programID, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    std::string name(static_cast<size_t>(std::max(maxNameLength, 1)), '\0');
+    for (GLint i = 0; i < uniformCount; ++i)
     {
-        SNAKE_LOG("Uniform not found: " << name);
-        return;
-    }
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(programID, static_cast<GLuint>(i), maxNameLength, &length, &size, &type, name.data());
+
+        std::string_view uniformName(name.data(), static_cast<size_t>(length));
+        GLint location = glGetUniformLocation(programID, name.c_str());
+        if (location == -1)
+            continue;
 
-    glUniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]);
+        uniformLocations[StringID::Intern(uniformName)] = location;
+
+        //arrays report "name[0]"; the bare name addresses the first element too
+        if (uniformName.size() > 3 && uniformName.substr(uniformName.size() - 3) == "[0]")
+            uniformLocations[StringID::Intern(uniformName.substr(0, uniformName.size() - 3))] = location;
+    }
 }
 
 bool Shader::SupportsInstancing() const
@@ -31,6 +31,30 @@ void StateManager::Update(float dt, const EngineContext& engineContext)
 	}
 }
 
+void StateManager::CheckCollision(const EngineContext& engineContext)
+{
+	if (currentState != nullptr)
+	{
+		currentState->SystemCollision(engineContext);
+	}
+}
+
+void StateManager::LateUpdate(float dt, const EngineContext& engineContext)
+{
+	if (currentState != nullptr)
+	{
+		currentState->SystemLateUpdate(dt, engineContext);
+	}
+}
+
+void StateManager::PrepareDraw(const EngineContext& engineContext)
+{
+	if (currentState != nullptr)
+	{
+		currentState->SystemPrepareDraw(engineContext);
+	}
+}
+
 void StateManager::Draw(const EngineContext& engineContext)
 {
 	if (currentState != nullptr)
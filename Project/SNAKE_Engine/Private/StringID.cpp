@@ -0,0 +1,47 @@
+#include "Engine.h"
+
+#include <iomanip>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+    struct StringIDRegistry
+    {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, std::string> names;
+    };
+
+    StringIDRegistry& GetRegistry()
+    {
+        static StringIDRegistry registry;
+        return registry;
+    }
+}
+
+StringID StringID::Intern(std::string_view str)
+{
+    const StringID id(str);
+    StringIDRegistry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    auto [it, inserted] = registry.names.try_emplace(id.hash, str);
+    if (!inserted && it->second != str)
+        SNAKE_ERR("StringID collision: \"" << str << "\" and \"" << it->second << "\" share hash " << id.hash);
+    return id;
+}
+
+std::string StringID::GetString() const
+{
+    StringIDRegistry& registry = GetRegistry();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto it = registry.names.find(hash);
+        if (it != registry.names.end())
+            return it->second;
+    }
+
+    std::ostringstream oss;
+    oss << "#" << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return oss.str();
+}
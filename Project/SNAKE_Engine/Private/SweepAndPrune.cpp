@@ -0,0 +1,120 @@
+#include "Engine.h"
+
+#include <algorithm>
+#include <numeric>
+
+void SweepAndPrune::BeginFrame()
+{
+    entries.clear();
+    isSorted = false;
+}
+
+void SweepAndPrune::Insert(Object* obj, const glm::vec2& boundsMin, const glm::vec2& boundsMax)
+{
+    entries.push_back({ obj, boundsMin, boundsMax });
+}
+
+void SweepAndPrune::Build()
+{
+    if (isSorted || entries.empty())
+        return;
+
+    //sweeping the axis the objects are spread along keeps the active interval short
+    glm::vec2 mean(0.f);
+    glm::vec2 meanSquared(0.f);
+    for (const Entry& entry : entries)
+    {
+        const glm::vec2 center = (entry.boundsMin + entry.boundsMax) * 0.5f;
+        mean += center;
+        meanSquared += center * center;
+    }
+    const float inverseCount = 1.f / static_cast<float>(entries.size());
+    const glm::vec2 variance = meanSquared * inverseCount - (mean * inverseCount) * (mean * inverseCount);
+    //switching axis costs a full sort, so only switch on a clear difference
+    SortAlongAxis(variance[1 - sortAxis] > variance[sortAxis] * 1.25f ? 1 - sortAxis : sortAxis);
+    isSorted = true;
+}
+
+void SweepAndPrune::ComputePairs(std::vector<BroadPhasePair>& outPairs)
+{
+    //order still holds last frame's indices when nothing was inserted
+    if (entries.empty())
+        return;
+    Build();
+
+    const int axis = sortAxis;
+    const int other = 1 - axis;
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        const Entry& a = entries[order[i]];
+        for (size_t j = i + 1; j < order.size(); ++j)
+        {
+            const Entry& b = entries[order[j]];
+            if (b.boundsMin[axis] > a.boundsMax[axis])
+                break;
+
+            if (a.boundsMin[other] > b.boundsMax[other] || b.boundsMin[other] > a.boundsMax[other])
+                continue;
+
+            outPairs.emplace_back(a.object, b.object);
+        }
+    }
+}
+
+void SweepAndPrune::QueryAABB(const glm::vec2& boundsMin, const glm::vec2& boundsMax, std::vector<Object*>& outObjects)
+{
+    auto overlaps = [&](const Entry& entry)
+        {
+            return boundsMin.x <= entry.boundsMax.x && entry.boundsMin.x <= boundsMax.x &&
+                boundsMin.y <= entry.boundsMax.y && entry.boundsMin.y <= boundsMax.y;
+        };
+
+    if (!isSorted)
+    {
+        for (const Entry& entry : entries)
+            if (overlaps(entry))
+                outObjects.push_back(entry.object);
+        return;
+    }
+
+    //nothing past the first entry starting beyond the query can overlap it
+    const int axis = sortAxis;
+    auto end = std::upper_bound(order.begin(), order.end(), boundsMax[axis],
+        [this, axis](float value, uint32_t index) { return value < entries[index].boundsMin[axis]; });
+    for (auto it = order.begin(); it != end; ++it)
+        if (overlaps(entries[*it]))
+            outObjects.push_back(entries[*it].object);
+}
+
+void SweepAndPrune::Reset()
+{
+    entries.clear();
+    order.clear();
+    isSorted = false;
+}
+
+void SweepAndPrune::SortAlongAxis(int axis)
+{
+    auto less = [this, axis](uint32_t a, uint32_t b) { return entries[a].boundsMin[axis] < entries[b].boundsMin[axis]; };
+
+    if (order.size() != entries.size() || axis != sortAxis)
+    {
+        sortAxis = axis;
+        order.resize(entries.size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::sort(order.begin(), order.end(), less);
+        return;
+    }
+
+    for (size_t i = 1; i < order.size(); ++i)
+    {
+        const uint32_t index = order[i];
+        size_t j = i;
+        while (j > 0 && less(index, order[j - 1]))
+        {
+            order[j] = order[j - 1];
+            --j;
+        }
+        order[j] = index;
+    }
+}
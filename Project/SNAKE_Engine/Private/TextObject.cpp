@@ -7,8 +7,8 @@ TextObject::TextObject(Font* font, const std::string& text, TextAlignH alignH_,
 
     textInstance.font = font;
     textInstance.text = text;
-    material = font->GetMaterial();
-    mesh = nullptr;
+    Object::SetMaterial(font->GetMaterial());
+    Object::SetMesh(nullptr);
 
     UpdateMesh();
 }
@@ -135,19 +135,26 @@ glm::vec2 TextObject::GetWorldScale() const
 
 void TextObject::CheckFontAtlasAndMeshUpdate()
 {
-    if (textAtlasVersionTracker == textInstance.font->GetTextAtlasVersion())
+    Font* font = textInstance.font;
+    bool isAtlasChanged = textAtlasVersionTracker != font->GetTextAtlasVersion();
+    bool hasGlyphsLanded = hasPendingGlyphs && textGlyphVersionTracker != font->GetGlyphVersion();
+    if (!isAtlasChanged && !hasGlyphsLanded)
         return;
 
-    textAtlasVersionTracker = textInstance.font->GetTextAtlasVersion();
-    std::unique_ptr<Mesh> newMesh(textInstance.font->GenerateTextMesh(textInstance.text, alignH, alignV));
-    mesh = newMesh.get();
-    textMesh = std::move(newMesh);
+    UpdateMesh();
 }
 
 void TextObject::UpdateMesh()
 {
+    Font* font = textInstance.font;
+    textAtlasVersionTracker = font->GetTextAtlasVersion();
+    textGlyphVersionTracker = font->GetGlyphVersion();
+
+    font->BuildTextGeometry(textInstance.text, alignH, alignV, textVertices, textIndices, &hasPendingGlyphs);
 
-    std::unique_ptr<Mesh> newMesh(textInstance.font->GenerateTextMesh(textInstance.text, alignH, alignV));
-    mesh = newMesh.get();
-    textMesh = std::move(newMesh);
+    //the mesh keeps its GL buffers across text edits and only re-uploads the new glyph quads
+    if (!textMesh)
+        textMesh = std::make_unique<DynamicMesh>(static_cast<GLsizei>(textVertices.size()), static_cast<GLsizei>(textIndices.size()), PrimitiveType::Triangles, Font::TEXT_VERTEX_LAYOUT);
+    textMesh->SetGeometry(textVertices, textIndices);
+    Object::SetMesh(textMesh.get());
 }
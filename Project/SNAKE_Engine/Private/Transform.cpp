@@ -1,7 +1,10 @@
 #include "Engine.h"
 
-glm::mat4& Transform2D::GetMatrix()
+glm::mat4 Transform2D::GetMatrix()
 {
+    if (row.store)
+        return row.store->GetMatrix(row.index);
+
     if (isChanged)
     {
         glm::mat4 t = glm::translate(glm::mat4(1.0f), glm::vec3(position, 0.0f));
@@ -0,0 +1,126 @@
+#include "Engine.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "gl.h"
+#include "gtc/packing.hpp"
+
+GLsizei VertexLayout::GetStride() const
+{
+    GLsizei stride = static_cast<GLsizei>(GetColorOffset());
+    if (hasColor)
+        stride += 4;
+    return stride;
+}
+
+GLuint VertexLayout::GetUVOffset() const
+{
+    return position == VertexPositionFormat::Float2 ? sizeof(glm::vec2) : sizeof(glm::vec3);
+}
+
+GLuint VertexLayout::GetColorOffset() const
+{
+    return GetUVOffset() + (uv == VertexUVFormat::Float2 ? sizeof(glm::vec2) : sizeof(uint16_t) * 2);
+}
+
+void VertexLayout::SetupAttributes(GLuint vao, GLuint vbo) const
+{
+    glVertexArrayVertexBuffer(vao, 0, vbo, 0, GetStride());
+
+    glEnableVertexArrayAttrib(vao, 0); // position
+    glVertexArrayAttribFormat(vao, 0, position == VertexPositionFormat::Float2 ? 2 : 3, GL_FLOAT, GL_FALSE, 0);
+    glVertexArrayAttribBinding(vao, 0, 0);
+
+    glEnableVertexArrayAttrib(vao, 1); // uv
+    switch (uv)
+    {
+    case VertexUVFormat::Float2:
+        glVertexArrayAttribFormat(vao, 1, 2, GL_FLOAT, GL_FALSE, GetUVOffset());
+        break;
+    case VertexUVFormat::Half2:
+        glVertexArrayAttribFormat(vao, 1, 2, GL_HALF_FLOAT, GL_FALSE, GetUVOffset());
+        break;
+    case VertexUVFormat::UNorm16x2:
+        glVertexArrayAttribFormat(vao, 1, 2, GL_UNSIGNED_SHORT, GL_TRUE, GetUVOffset());
+        break;
+    }
+    glVertexArrayAttribBinding(vao, 1, 0);
+
+    if (hasColor)
+    {
+        glEnableVertexArrayAttrib(vao, COLOR_LOCATION);
+        glVertexArrayAttribFormat(vao, COLOR_LOCATION, 4, GL_UNSIGNED_BYTE, GL_TRUE, GetColorOffset());
+        glVertexArrayAttribBinding(vao, COLOR_LOCATION, 0);
+    }
+    else
+    {
+        glDisableVertexArrayAttrib(vao, COLOR_LOCATION);
+    }
+}
+
+void VertexLayout::PackVertices(const std::vector<Vertex>& vertices, std::vector<unsigned char>& out) const
+{
+    PackVertices(vertices.data(), vertices.size(), out);
+}
+
+void VertexLayout::PackVertices(const Vertex* vertices, size_t count, std::vector<unsigned char>& out) const
+{
+    const GLsizei stride = GetStride();
+    const GLuint uvOffset = GetUVOffset();
+    const GLuint colorOffset = GetColorOffset();
+    const size_t positionSize = position == VertexPositionFormat::Float2 ? sizeof(glm::vec2) : sizeof(glm::vec3);
+
+    out.resize(count * stride);
+    unsigned char* dst = out.data();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const Vertex& v = vertices[i];
+        std::memcpy(dst, &v.position, positionSize);
+
+        switch (uv)
+        {
+        case VertexUVFormat::Float2:
+            std::memcpy(dst + uvOffset, &v.uv, sizeof(glm::vec2));
+            break;
+        case VertexUVFormat::Half2:
+        {
+            uint32_t packed = glm::packHalf2x16(v.uv);
+            std::memcpy(dst + uvOffset, &packed, sizeof(packed));
+            break;
+        }
+        case VertexUVFormat::UNorm16x2:
+        {
+            //unorm UVs clamp to [0, 1]; layouts that tile UVs past the edge should use Half2
+            uint32_t packed = glm::packUnorm2x16(v.uv);
+            std::memcpy(dst + uvOffset, &packed, sizeof(packed));
+            break;
+        }
+        }
+
+        if (hasColor)
+        {
+            uint32_t packed = glm::packUnorm4x8(v.color);
+            std::memcpy(dst + colorOffset, &packed, sizeof(packed));
+        }
+        dst += stride;
+    }
+}
+
+bool VertexLayout::PackIndices(const std::vector<unsigned int>& indices, size_t vertexCount, std::vector<unsigned char>& out)
+{
+    const bool useShort = vertexCount <= 0x10000;
+    if (useShort)
+    {
+        out.resize(indices.size() * sizeof(uint16_t));
+        uint16_t* dst = reinterpret_cast<uint16_t*>(out.data());
+        for (size_t i = 0; i < indices.size(); ++i)
+            dst[i] = static_cast<uint16_t>(indices[i]);
+    }
+    else
+    {
+        out.resize(indices.size() * sizeof(unsigned int));
+        std::memcpy(out.data(), indices.data(), out.size());
+    }
+    return useShort;
+}
@@ -2,6 +2,7 @@
 #include <unordered_map>
 
 #include "vec2.hpp"
+#include "StringID.h"
 #include "Texture.h"
 struct SpriteFrame
 {
@@ -32,9 +33,10 @@ public:
 
     void AddClip(const std::string& name, const std::vector<int>& frames, float frameDuration, bool looping=true);
     [[nodiscard]] const SpriteClip* GetClip(const std::string& name) const;
+    [[nodiscard]] const SpriteClip* GetClip(StringID name) const;
 
 private:
-    std::unordered_map<std::string, SpriteClip> animationClips;
+    std::unordered_map<StringID, SpriteClip> animationClips;
     Texture* texture;
     int frameWidth, frameHeight;
     int columns, rows;
@@ -51,6 +53,7 @@ public:
 
     void PlayClip(int start, int end, bool loop_ = true);
     void PlayClip(const std::string& clipName);
+    void PlayClip(StringID clipName);
 
     void Update(float dt);
 
@@ -0,0 +1,69 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "glm.hpp"
+
+class Object;
+
+enum class BroadPhaseType : uint8_t
+{
+    SpatialHashGrid,
+    DynamicAABBTree,
+    SweepAndPrune,
+    HierarchicalGrid
+};
+
+using BroadPhasePair = std::pair<Object*, Object*>;
+
+//finds the pairs of objects whose bounds overlap; every collider is inserted again each frame,
+//implementations that keep state across frames use that to update only what moved
+class BroadPhase
+{
+public:
+    virtual ~BroadPhase() = default;
+
+    [[nodiscard]] virtual BroadPhaseType GetType() const = 0;
+
+    //objects that are not inserted again before ComputePairs are dropped
+    virtual void BeginFrame() = 0;
+
+    virtual void Insert(Object* obj, const glm::vec2& boundsMin, const glm::vec2& boundsMax) = 0;
+
+    //makes this frame's inserts queryable without computing pairs; ComputePairs does it as well
+    virtual void Build() = 0;
+
+    //appends every overlapping pair exactly once
+    virtual void ComputePairs(std::vector<BroadPhasePair>& outPairs) = 0;
+
+    //appends every object whose bounds overlap [boundsMin, boundsMax], as inserted for the last Build
+    virtual void QueryAABB(const glm::vec2& boundsMin, const glm::vec2& boundsMax, std::vector<Object*>& outObjects) = 0;
+
+    //forgets every object, including anything kept across frames
+    virtual void Reset() = 0;
+};
+
+//counts bounds by the power of two their larger side rounds up to; the grids pick their cell size from it
+class BoundsSizeHistogram
+{
+public:
+    void Clear();
+    void Add(const glm::vec2& boundsMin, const glm::vec2& boundsMax);
+
+    [[nodiscard]] bool IsEmpty() const { return total == 0; }
+    //smallest power of two that at least fraction of the added bounds fit in
+    [[nodiscard]] int GetPercentile(float fraction) const;
+
+private:
+    static constexpr int BUCKET_COUNT = 31;
+
+    std::array<uint32_t, BUCKET_COUNT> counts{};
+    uint32_t total = 0;
+};
+
+[[nodiscard]] std::unique_ptr<BroadPhase> CreateBroadPhase(BroadPhaseType type);
+
+[[nodiscard]] const char* GetBroadPhaseName(BroadPhaseType type);
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "BroadPhase.h"
+
+class ObjectManager;
+
+struct BroadPhaseBenchmarkSettings
+{
+    size_t objectCount = 2000;
+    //sizes are drawn uniformly from this list; empty uses a mix of bullets, characters and a few screen-sized triggers
+    std::vector<glm::vec2> colliderSizes;
+    glm::vec2 worldSize = { 1600.f, 900.f };
+    float movingRatio = 0.8f;
+    float maxSpeed = 400.f;
+    int frameCount = 120;
+    float dt = 1.f / 60.f;
+    uint32_t seed = 1;
+};
+
+struct BroadPhaseBenchmarkResult
+{
+    BroadPhaseType type;
+    float averageMilliseconds = 0.f;
+    float worstMilliseconds = 0.f;
+    size_t totalPairs = 0;
+};
+
+class BroadPhaseBenchmark
+{
+public:
+    //feeds the same simulated frames through every broad phase; warns if they disagree on the pairs found
+    [[nodiscard]] static std::vector<BroadPhaseBenchmarkResult> Run(const BroadPhaseBenchmarkSettings& settings = {});
+
+    //collider bounds sizes of the live objects, so a scene's own size distribution can be benchmarked
+    [[nodiscard]] static std::vector<glm::vec2> SampleColliderSizes(const ObjectManager& objectManager);
+
+    static void LogResults(const std::vector<BroadPhaseBenchmarkResult>& results);
+};
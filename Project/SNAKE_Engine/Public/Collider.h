@@ -6,9 +6,13 @@
 
 #include "glm.hpp"
 
+#include "BroadPhase.h"
+
 
 class SpatialHashGrid;
+class HierarchicalGrid;
 class ObjectManager;
+class ObjectComponentStore;
 class Camera2D;
 class RenderManager;
 class Object;
@@ -25,15 +29,19 @@ enum class ColliderType
 class Collider
 {
     friend ObjectManager;
-    friend CircleCollider;
-    friend AABBCollider;
+    friend ObjectComponentStore;
     friend SpatialHashGrid;
 public:
     Collider() = delete;
     Collider(Object* owner_) : owner(owner_), worldPosition(){}
     virtual ~Collider() = default;
 
-    void SetUseTransformScale(bool use) { useTransformScale = use; }
+    void SetUseTransformScale(bool use);
+
+    //static colliders live in a separate grid that is only rebuilt when one of them moves or changes,
+    //and two static colliders are never tested against each other
+    void SetStatic(bool isStatic_);
+    [[nodiscard]] bool IsStatic() const { return isStatic; }
     [[nodiscard]] bool IsUsingTransformScale() const { return useTransformScale; }
 
     void SetWorldPosition(const glm::vec2& pos) { worldPosition = pos; }
@@ -48,31 +56,33 @@ protected:
 
     [[nodiscard]] virtual float GetBoundingRadius() const = 0;
 
-    [[nodiscard]] virtual bool CheckCollision(const Collider* other) const = 0;
-
-    [[nodiscard]] virtual bool DispatchAgainst(const CircleCollider& other) const = 0;
-    [[nodiscard]] virtual bool DispatchAgainst(const AABBCollider& other) const = 0;
+    //size as of the last SyncWithTransformScale: the radius in both components, or the half size
+    [[nodiscard]] virtual glm::vec2 GetShapeExtent() const = 0;
 
+    //recomputes the scaled size from the owner's world scale; the collision pass does this once per frame
     virtual void SyncWithTransformScale() = 0;
+    //resyncs after a size change and lets the owner's row pick it up
+    void RefreshShape();
 
     virtual void DrawDebug(RenderManager* rm, Camera2D* cam, const glm::vec4& color = { 1,0,0,1 }) const = 0;
 
     Object* owner;
     bool useTransformScale = true;
+    bool isStatic = false;
     glm::vec2 worldPosition;
 };
 
 
 class CircleCollider : public Collider
 {
-    friend AABBCollider;
     friend SpatialHashGrid;
 public:
     CircleCollider(Object* owner, float size)
         : Collider(owner), baseRadius(size/2.f), scaledRadius(size/2.f) {
     }
 
-    [[nodiscard]] float GetRadius() const;
+    //as of the last sync: the collider sync that feeds the narrow phase each collision pass, or a change to the collider itself
+    [[nodiscard]] float GetRadius() const { return scaledRadius; }
 
     [[nodiscard]] float GetSize() const;
 
@@ -85,10 +95,7 @@ private:
 
     [[nodiscard]] float GetBoundingRadius() const override;
 
-    [[nodiscard]] bool CheckCollision(const Collider* other) const override;
-    
-    [[nodiscard]] bool DispatchAgainst(const CircleCollider& other) const override;
-    [[nodiscard]] bool DispatchAgainst(const AABBCollider& other) const override;
+    [[nodiscard]] glm::vec2 GetShapeExtent() const override { return glm::vec2(scaledRadius); }
 
     void SyncWithTransformScale() override;
 
@@ -101,14 +108,14 @@ private:
 
 class AABBCollider : public Collider
 {
-    friend CircleCollider;
     friend SpatialHashGrid;
 public:
     AABBCollider(Object* owner, const glm::vec2& size)
         : Collider(owner), baseHalfSize(size/glm::vec2(2)), scaledHalfSize(size / glm::vec2(2)) {
     }
 
-    [[nodiscard]] glm::vec2 GetHalfSize() const;
+    //as of the last sync: the collider sync that feeds the narrow phase each collision pass, or a change to the collider itself
+    [[nodiscard]] glm::vec2 GetHalfSize() const { return scaledHalfSize; }
 
     [[nodiscard]] glm::vec2 GetSize() const;
     void SetSize(const glm::vec2& hs);
@@ -120,10 +127,7 @@ private:
 
     [[nodiscard]] float GetBoundingRadius() const override;
 
-    [[nodiscard]] bool CheckCollision(const Collider* other) const override;
-
-    [[nodiscard]] bool DispatchAgainst(const CircleCollider& other) const override;
-    [[nodiscard]] bool DispatchAgainst(const AABBCollider& other) const override;
+    [[nodiscard]] glm::vec2 GetShapeExtent() const override { return scaledHalfSize; }
 
     void SyncWithTransformScale() override;
 
@@ -133,32 +137,174 @@ private:
     glm::vec2 scaledHalfSize = { 0.5f, 0.5f };
 };
 
-struct Vec2Hash
+//inserts are buffered and sorted into cells by a counting sort (count, prefix sum, scatter) over an
+//open-addressed cell table; every buffer is reused across frames, so a steady scene allocates nothing
+class SpatialHashGrid : public BroadPhase
 {
-    size_t operator()(const glm::ivec2& v) const
+    friend ObjectManager;
+    friend HierarchicalGrid;
+public:
+    static constexpr int MIN_CELL_SIZE = 8;
+    static constexpr int MAX_CELL_SIZE = 4096;
+
+    [[nodiscard]] BroadPhaseType GetType() const override { return BroadPhaseType::SpatialHashGrid; }
+
+    void BeginFrame() override { Clear(); }
+
+    void Insert(Object* obj, const glm::vec2& boundsMin, const glm::vec2& boundsMax) override;
+
+    void Build() override;
+
+    void ComputePairs(std::vector<BroadPhasePair>& outPairs) override
     {
-        return std::hash<int>()(v.x * 73856093 ^ v.y * 19349663);
+        ComputeCollisions([&outPairs](Object* a, Object* b) { outPairs.emplace_back(a, b); });
     }
-};
 
-class SpatialHashGrid
-{
-    friend ObjectManager;
+    void QueryAABB(const glm::vec2& boundsMin, const glm::vec2& boundsMax, std::vector<Object*>& outObjects) override
+    {
+        Query(boundsMin, boundsMax, [&outObjects](Object* obj) { outObjects.push_back(obj); });
+    }
+
+    void Reset() override;
+
+    //fixes the cell size and turns off tuning
+    void SetCellSize(int size);
+    //on by default: each build sizes the cells to fit 90% of the colliders, so most cover at most 2x2 cells
+    void SetAutoTuneCellSize(bool autoTune) { autoTuneCellSize = autoTune; }
+    [[nodiscard]] int GetCellSize() const { return cellSize; }
+
 private:
+    struct Entry
+    {
+        Object* object;
+        glm::vec2 boundsMin;
+        glm::vec2 boundsMax;
+        glm::ivec2 minCell;
+        glm::ivec2 maxCell;
+    };
+
+    struct Cell
+    {
+        glm::ivec2 coord;
+        uint32_t start = 0;
+        uint32_t count = 0;
+        //a slot is only occupied if its stamp matches the current build
+        uint32_t stamp = 0;
+    };
+
     void Clear();
-    void Insert(Object* obj);
-    void ComputeCollisions(std::function<void(Object*, Object*)> onCollision);
+    //calls onPair(a, b) once per pair whose bounds overlap: only the cell holding the min corner of the
+    //overlap reports it, so pairs sharing several cells need no dedupe set
+    template<typename Callback>
+    void ComputeCollisions(Callback&& onPair)
+    {
+        Build();
+
+        for (uint32_t slot : usedCells)
+        {
+            const Cell& cell = table[slot];
+            const uint32_t* list = cellEntries.data() + cell.start;
+            for (uint32_t i = 0; i < cell.count; ++i)
+            {
+                const Entry& a = entries[list[i]];
+                for (uint32_t j = i + 1; j < cell.count; ++j)
+                {
+                    const Entry& b = entries[list[j]];
+                    if (a.boundsMin.x > b.boundsMax.x || b.boundsMin.x > a.boundsMax.x ||
+                        a.boundsMin.y > b.boundsMax.y || b.boundsMin.y > a.boundsMax.y)
+                        continue;
+
+                    if (GetCell(glm::max(a.boundsMin, b.boundsMin)) != cell.coord)
+                        continue;
+
+                    onPair(a.object, b.object);
+                }
+            }
+        }
+    }
+    //calls onHit(object) once per built entry whose bounds overlap [boundsMin, boundsMax]
+    template<typename Callback>
+    void Query(const glm::vec2& boundsMin, const glm::vec2& boundsMax, Callback&& onHit) const
+    {
+        if (!isBuilt || entries.empty())
+            return;
+
+        //clamping to what was inserted keeps huge query boxes from walking empty cells
+        const glm::vec2 clampedMin = glm::max(boundsMin, entriesMin);
+        const glm::vec2 clampedMax = glm::min(boundsMax, entriesMax);
+        if (clampedMin.x > clampedMax.x || clampedMin.y > clampedMax.y)
+            return;
+
+        const glm::ivec2 minCell = GetCell(clampedMin);
+        const glm::ivec2 maxCell = GetCell(clampedMax);
+        //a box spanning more cells than there are entries is answered faster by scanning the entries
+        if (static_cast<size_t>(maxCell.x - minCell.x + 1) * static_cast<size_t>(maxCell.y - minCell.y + 1) > entries.size())
+        {
+            for (const Entry& entry : entries)
+            {
+                if (boundsMin.x <= entry.boundsMax.x && entry.boundsMin.x <= boundsMax.x &&
+                    boundsMin.y <= entry.boundsMax.y && entry.boundsMin.y <= boundsMax.y)
+                    onHit(entry.object);
+            }
+            return;
+        }
+
+        for (int y = minCell.y; y <= maxCell.y; ++y)
+        {
+            for (int x = minCell.x; x <= maxCell.x; ++x)
+            {
+                const Cell* cell = FindCell({ x, y });
+                if (!cell)
+                    continue;
+
+                const uint32_t* list = cellEntries.data() + cell->start;
+                for (uint32_t i = 0; i < cell->count; ++i)
+                {
+                    const Entry& entry = entries[list[i]];
+                    if (boundsMin.x > entry.boundsMax.x || entry.boundsMin.x > boundsMax.x ||
+                        boundsMin.y > entry.boundsMax.y || entry.boundsMin.y > boundsMax.y)
+                        continue;
+
+                    //same rule as ComputeCollisions: only the cell holding the overlap's min corner reports
+                    if (GetCell(glm::max(boundsMin, entry.boundsMin)) != cell->coord)
+                        continue;
+
+                    onHit(entry.object);
+                }
+            }
+        }
+    }
     [[nodiscard]] glm::ivec2 GetCell(const glm::vec2& pos) const;
-    void InsertToCell(Object* obj, const glm::ivec2& cell);
-
-    int cellSize = 50; 
-    std::unordered_map<glm::ivec2, std::vector<Object*>, Vec2Hash> grid;
+    void TuneCellSize();
+    //recomputes every entry's cell range after a cell size change
+    void AssignCells();
+    [[nodiscard]] uint32_t FindOrAddCell(const glm::ivec2& coord);
+    [[nodiscard]] const Cell* FindCell(const glm::ivec2& coord) const;
+    [[nodiscard]] static uint64_t HashCell(const glm::ivec2& coord);
+
+    int cellSize = 64;
+    bool autoTuneCellSize = true;
+    BoundsSizeHistogram sizeHistogram;
+    std::vector<Entry> entries;
+    glm::vec2 entriesMin = glm::vec2(0.f);
+    glm::vec2 entriesMax = glm::vec2(0.f);
+    size_t coverCount = 0;
+    bool isBuilt = false;
+
+    std::vector<Cell> table;
+    uint32_t stamp = 0;
+    std::vector<uint32_t> usedCells;
+    //table slot of every (entry, covered cell) pair in insertion order, so the scatter pass skips the lookups
+    std::vector<uint32_t> entryCells;
+    //entry indices grouped by cell
+    std::vector<uint32_t> cellEntries;
 };
 
 class CollisionGroupRegistry
 {
     friend Collider;
     friend Object;
+    friend ObjectManager;
 private:
     [[nodiscard]] uint32_t GetGroupBit(const std::string& tag);
     [[nodiscard]] std::string GetGroupTag(uint32_t bit) const;
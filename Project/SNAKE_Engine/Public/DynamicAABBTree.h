@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "BroadPhase.h"
+
+//bounding volume tree over fattened bounds; a leaf is only reinserted once its object leaves the fat box,
+//so slow or resting objects cost a lookup per frame. Rotations keep the tree balanced as leaves move
+class DynamicAABBTree : public BroadPhase
+{
+public:
+    [[nodiscard]] BroadPhaseType GetType() const override { return BroadPhaseType::DynamicAABBTree; }
+
+    void BeginFrame() override { ++frame; }
+
+    void Insert(Object* obj, const glm::vec2& boundsMin, const glm::vec2& boundsMax) override;
+
+    void Build() override;
+
+    void ComputePairs(std::vector<BroadPhasePair>& outPairs) override;
+
+    void QueryAABB(const glm::vec2& boundsMin, const glm::vec2& boundsMax, std::vector<Object*>& outObjects) override;
+
+    void Reset() override;
+
+    //fixed padding added on each side, on top of fatMarginScale times the object size
+    void SetFatMargin(float margin, float scale = 0.1f) { fatMargin = margin; fatMarginScale = scale; }
+
+    [[nodiscard]] int GetHeight() const { return root == NULL_NODE ? 0 : nodes[root].height; }
+
+private:
+    static constexpr int NULL_NODE = -1;
+
+    struct Node
+    {
+        glm::vec2 fatMin;
+        glm::vec2 fatMax;
+        //only set on leaves
+        glm::vec2 boundsMin;
+        glm::vec2 boundsMax;
+        Object* object = nullptr;
+        //next free node while on the free list
+        int parent = NULL_NODE;
+        int child1 = NULL_NODE;
+        int child2 = NULL_NODE;
+        //leaf 0, free -1
+        int height = -1;
+        uint32_t leafSlot = 0;
+        uint32_t lastSeenFrame = 0;
+
+        [[nodiscard]] bool IsLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    [[nodiscard]] int AllocateNode();
+    void FreeNode(int node);
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    void RemoveProxy(int leaf);
+    void Refit(int node);
+    [[nodiscard]] int Balance(int node);
+    void Fatten(Node& leaf) const;
+
+    std::vector<Node> nodes;
+    int root = NULL_NODE;
+    int freeList = NULL_NODE;
+
+    std::unordered_map<Object*, int> leafOf;
+    std::vector<int> leaves;
+    std::vector<int> queryStack;
+    uint32_t frame = 0;
+
+    float fatMargin = 4.f;
+    float fatMarginScale = 0.1f;
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <vector>
+
+#include "Mesh.h"
+
+class DynamicMesh : public Mesh
+{
+public:
+    DynamicMesh(GLsizei vertexCapacity, GLsizei indexCapacity, PrimitiveType primitiveType = PrimitiveType::Triangles, const VertexLayout& layout = {});
+
+    //resizes the CPU-side copy and returns a pointer for the caller to fill; the written range is uploaded on Commit
+    [[nodiscard]] Vertex* MapVertices(GLsizei vertexCount);
+
+    [[nodiscard]] unsigned int* MapIndices(GLsizei indexCount);
+
+    //overwrites a range starting at offset, growing the used count if the range runs past it
+    void WriteVertices(GLsizei offset, const std::vector<Vertex>& vertices);
+
+    void WriteIndices(GLsizei offset, const std::vector<unsigned int>& indices);
+
+    void Commit();
+
+    //replaces the whole contents; equivalent to Map, fill and Commit
+    void SetGeometry(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+
+    [[nodiscard]] GLsizei GetVertexCapacity() const { return vertexCapacity; }
+
+    [[nodiscard]] GLsizei GetIndexCapacity() const { return indexCapacity; }
+
+    [[nodiscard]] GLsizei GetVertexCount() const { return static_cast<GLsizei>(vertices.size()); }
+
+    [[nodiscard]] GLsizei GetIndexCount() const { return static_cast<GLsizei>(indices.size()); }
+
+private:
+    void MarkVerticesDirty(GLsizei begin, GLsizei end);
+
+    void MarkIndicesDirty(GLsizei begin, GLsizei end);
+
+    [[nodiscard]] bool Reserve(GLsizei requiredVertices, GLsizei requiredIndices);
+
+    void UploadVertices(GLsizei begin, GLsizei end);
+
+    void UploadIndices(GLsizei begin, GLsizei end);
+
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    std::vector<unsigned char> packed;
+
+    GLsizei vertexCapacity = 0;
+    GLsizei indexCapacity = 0;
+
+    GLsizei dirtyVertexBegin = 0;
+    GLsizei dirtyVertexEnd = 0;
+    GLsizei dirtyIndexBegin = 0;
+    GLsizei dirtyIndexEnd = 0;
+};
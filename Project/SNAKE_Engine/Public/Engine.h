@@ -12,8 +12,14 @@
 #include "CameraManager.h"
 #include "RenderLayerManager.h"
 #include "EngineTimer.h"
+#include "JobSystem.h"
+#include "FrameTaskGraph.h"
+#include "StringID.h"
 
 #include "Object.h"
+#include "ObjectComponentStore.h"
+#include "ObjectQuery.h"
+#include "Prefab.h"
 #include "TextObject.h"
 #include "GameObject.h"
 
@@ -22,9 +28,20 @@
 #include "Transform.h"
 #include "Material.h"
 #include "Mesh.h"
+#include "DynamicMesh.h"
+#include "VertexLayout.h"
+#include "MeshArena.h"
 #include "Font.h"
+#include "GlyphAtlas.h"
+#include "GlyphRasterizer.h"
 #include "Camera2D.h"
 #include "Collider.h"
+#include "BroadPhase.h"
+#include "DynamicAABBTree.h"
+#include "SweepAndPrune.h"
+#include "HierarchicalGrid.h"
+#include "BroadPhaseBenchmark.h"
+#include "NarrowPhase.h"
 #include "Animation.h"
 
 #include "Debug.h"
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "InputManager.h"
+#include "JobSystem.h"
 #include "RenderManager.h"
 #include "SoundManager.h"
 #include "StateManager.h"
@@ -16,5 +17,6 @@ struct EngineContext
     InputManager* inputManager = nullptr;
     RenderManager* renderManager = nullptr;
     SoundManager* soundManager = nullptr;
+    JobSystem* jobSystem = nullptr;
     SNAKE_Engine* engine = nullptr;
 };
@@ -2,7 +2,9 @@
 
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
+#include <vector>
 
 #include "glm.hpp"
 #include "ft2build.h"
@@ -10,8 +12,12 @@
 
 #include "Texture.h"
 #include "Material.h"
+#include "VertexLayout.h"
 
 class Camera2D;
+class GlyphRasterizer;
+class GlyphAtlas;
+struct RasterizedGlyph;
 
 
 struct EngineContext;
@@ -37,45 +43,54 @@ struct Glyph
     uint32_t advance;
     glm::vec2 uvTopLeft;
     glm::vec2 uvBottomRight;
+    bool isResident = false;
 };
 
 class Font
 {
+    friend GlyphRasterizer;
+    friend GlyphAtlas;
+    friend RenderManager;
 public:
     Font(RenderManager& engineContext, const std::string& ttfPath, uint32_t fontSize);
     ~Font();
 
-    [[nodiscard]] Material* GetMaterial() const { return material.get(); }
+    [[nodiscard]] Material* GetMaterial() const;
 
     [[nodiscard]] glm::vec2 GetTextSize(const std::string& text) const;
 
-    [[nodiscard]] Mesh* GenerateTextMesh(const std::string& text, TextAlignH alignH = TextAlignH::Left, TextAlignV alignV = TextAlignV::Top);
+    [[nodiscard]] Mesh* GenerateTextMesh(const std::string& text, TextAlignH alignH = TextAlignH::Left, TextAlignV alignV = TextAlignV::Top, bool* hasPendingGlyphs = nullptr);
 
-    int GetTextAtlasVersion() { return atlasVersion; }
+    void BuildTextGeometry(const std::string& text, TextAlignH alignH, TextAlignV alignV, std::vector<Vertex>& outVertices, std::vector<unsigned int>& outIndices, bool* hasPendingGlyphs = nullptr);
+
+    //glyph quads are flat and their UVs stay inside the atlas, so the compact layout loses nothing
+    static constexpr VertexLayout TEXT_VERTEX_LAYOUT = { VertexPositionFormat::Float2, VertexUVFormat::UNorm16x2, false };
+
+    [[nodiscard]] int GetTextAtlasVersion() const;
+
+    [[nodiscard]] int GetGlyphVersion() const { return glyphVersion; }
 
 private:
-    void LoadFont(const std::string& path, uint32_t fontSize);
+    void LoadFont(const std::string& path);
 
-    void BakeAtlas(RenderManager& renderManager);
+    void BakeFallbackGlyph();
 
     [[nodiscard]] const Glyph& GetGlyph(char32_t c) const;
 
     [[nodiscard]] bool TryBakeGlyph(char32_t c);
 
-    void ExpandAtlas();
+    [[nodiscard]] bool RequestGlyph(char32_t c);
 
-    FT_Library ft;
-    FT_Face face;
+    void CommitGlyph(const RasterizedGlyph& rasterized);
 
-    uint32_t fontSize;
+    GlyphRasterizer* rasterizer;
+    GlyphAtlas* atlas;
+    std::vector<FT_Byte> fontData;
+    FT_Face face = nullptr;
 
-    std::unordered_map<char32_t, Glyph> glyphs;
-    std::unique_ptr<Texture> atlasTexture;
-    std::unique_ptr<Material> material;
+    uint32_t fontSize;
 
-    int nextX = 0;
-    int nextY = 0;
-    int maxRowHeight = 0;
+    std::unordered_set<char32_t> failedGlyphs;
 
-    int atlasVersion = 0;
+    int glyphVersion = 0;
 };
@@ -0,0 +1,53 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "JobSystem.h"
+
+using FrameStageID = size_t;
+
+struct FrameStageTiming
+{
+    std::string name;
+    //offset from the start of the frame graph run
+    float startMilliseconds = 0.f;
+    float durationMilliseconds = 0.f;
+    bool ranOnMainThread = true;
+};
+
+//a frame described as stages with dependencies; stages without a path between them may run concurrently
+class FrameTaskGraph
+{
+public:
+    //dependencies must be stages added earlier; worker stages may not touch OpenGL, GLFW or game code
+    FrameStageID AddStage(const std::string& name, std::function<void()> function, const std::vector<FrameStageID>& dependencies = {}, bool isMainThreadOnly = true);
+
+    void Clear();
+
+    //blocks the calling (main) thread until every stage has run, executing main-thread stages itself
+    void Run(JobSystem& jobSystem);
+
+    //timings of the last completed run, in the order the stages were added
+    [[nodiscard]] const std::vector<FrameStageTiming>& GetTimings() const { return timings; }
+
+    [[nodiscard]] float GetFrameMilliseconds() const { return frameMilliseconds; }
+
+    void LogTimings() const;
+
+private:
+    struct Stage
+    {
+        std::string name;
+        std::function<void()> function;
+        std::vector<FrameStageID> dependencies;
+        bool isMainThreadOnly = true;
+    };
+
+    std::vector<Stage> stages;
+    std::vector<JobHandle> handles;
+    std::vector<FrameStageTiming> runningTimings;
+    std::vector<FrameStageTiming> timings;
+    float frameMilliseconds = 0.f;
+};
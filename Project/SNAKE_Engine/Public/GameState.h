@@ -32,6 +32,7 @@ protected:
 
     virtual void Load([[maybe_unused]] const EngineContext& engineContext) {}
 
+    //runs on the main thread after culling, so playing or stopping sounds here is fine
     virtual void Draw([[maybe_unused]] const EngineContext& engineContext)
     {
         objectManager.DrawAll(engineContext);
@@ -64,17 +65,30 @@ private:
         objectManager.AddAllPendingObjects(engineContext);
     }
 
+    //the engine's frame graph runs these in order: SystemUpdate -> SystemCollision -> SystemLateUpdate -> SystemPrepareDraw -> Draw
     virtual void SystemUpdate(float dt, const EngineContext& engineContext)
     {
         Update(dt, engineContext);
+    }
 
+    virtual void SystemCollision(const EngineContext& engineContext)
+    {
         objectManager.CheckCollision();
         if (engineContext.engine->ShouldRenderDebugDraws())
             objectManager.DrawColliderDebug(engineContext.renderManager, cameraManager.GetActiveCamera());
+    }
 
+    virtual void SystemLateUpdate(float dt, const EngineContext& engineContext)
+    {
         LateUpdate(dt, engineContext);
     }
 
+    //runs on a worker thread, so it may only read object and camera state
+    virtual void SystemPrepareDraw(const EngineContext& engineContext)
+    {
+        objectManager.PrepareDraw(engineContext);
+    }
+
     virtual void SystemFree(const EngineContext& engineContext)
     {
         Free(engineContext);
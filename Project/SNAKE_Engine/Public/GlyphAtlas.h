@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "Font.h"
+
+class RenderManager;
+
+struct GlyphKey
+{
+    const Font* font;
+    uint32_t pixelSize;
+    char32_t codepoint;
+
+    bool operator==(const GlyphKey& other) const
+    {
+        return font == other.font && pixelSize == other.pixelSize && codepoint == other.codepoint;
+    }
+};
+
+namespace std
+{
+    template<>
+    struct hash<GlyphKey>
+    {
+        std::size_t operator()(const GlyphKey& key) const noexcept
+        {
+            //the size and codepoint are packed in 64 bits and the constant matches size_t, so Win32 builds hash the same way
+            constexpr std::size_t GOLDEN_RATIO = sizeof(std::size_t) >= 8 ? static_cast<std::size_t>(0x9e3779b97f4a7c15ull) : static_cast<std::size_t>(0x9e3779b9u);
+            std::size_t h1 = std::hash<const Font*>()(key.font);
+            std::size_t h2 = std::hash<uint64_t>()((static_cast<uint64_t>(key.pixelSize) << 32) | static_cast<uint64_t>(key.codepoint));
+            return h1 ^ (h2 + GOLDEN_RATIO + (h1 << 6) + (h1 >> 2));
+        }
+    };
+}
+
+class GlyphAtlas
+{
+    friend RenderManager;
+    friend Font;
+public:
+    [[nodiscard]] Material* GetMaterial() const { return material.get(); }
+
+    [[nodiscard]] Texture* GetTexture() const { return texture.get(); }
+
+    [[nodiscard]] int GetVersion() const { return version; }
+
+private:
+    void Init(RenderManager& renderManager);
+
+    [[nodiscard]] const Glyph* Find(const GlyphKey& key) const;
+
+    void SetPlaceholder(const GlyphKey& key, uint32_t advance);
+
+    void Pack(const GlyphKey& key, const RasterizedGlyph& rasterized);
+
+    void Erase(const GlyphKey& key);
+
+    void Release(const Font* font);
+
+    void Expand();
+
+    std::unordered_map<GlyphKey, Glyph> glyphs;
+    std::unique_ptr<Texture> texture;
+    std::unique_ptr<Material> material;
+
+    int nextX = 0;
+    int nextY = 0;
+    int maxRowHeight = 0;
+
+    int version = 0;
+};
@@ -0,0 +1,80 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "glm.hpp"
+#include "ft2build.h"
+#include FT_FREETYPE_H
+
+class Font;
+class RenderManager;
+
+struct RasterizedGlyph
+{
+    Font* font = nullptr;
+    char32_t codepoint = 0;
+    bool isValid = false;
+    glm::ivec2 size = { 0, 0 };
+    glm::ivec2 bearing = { 0, 0 };
+    uint32_t advance = 0;
+    std::vector<unsigned char> bitmap;
+};
+
+class GlyphRasterizer
+{
+    friend RenderManager;
+    friend Font;
+public:
+    GlyphRasterizer() = default;
+    ~GlyphRasterizer();
+
+    GlyphRasterizer(const GlyphRasterizer&) = delete;
+    GlyphRasterizer& operator=(const GlyphRasterizer&) = delete;
+
+    static bool Rasterize(FT_Face face, char32_t codepoint, RasterizedGlyph& out);
+
+    [[nodiscard]] bool IsRunning() const { return isRunning; }
+
+private:
+    void Init(unsigned int workerCount = 0);
+
+    void Shutdown();
+
+    [[nodiscard]] FT_Face OpenFace(const Font& font);
+
+    void CloseFace(FT_Face face);
+
+    [[nodiscard]] FT_Face CreateFace(const Font& font);
+
+    void Request(Font* font, char32_t codepoint);
+
+    void ReleaseFont(const Font* font);
+
+    void CollectResults(std::vector<RasterizedGlyph>& out);
+
+    void WorkerLoop(size_t workerIndex);
+
+    struct GlyphJob
+    {
+        Font* font;
+        char32_t codepoint;
+    };
+
+    FT_Library library = nullptr;
+
+    std::vector<std::thread> workers;
+    std::vector<std::unordered_map<const Font*, FT_Face>> workerFaces;
+    std::vector<const Font*> busyFonts;
+
+    std::deque<GlyphJob> jobs;
+    std::vector<RasterizedGlyph> results;
+
+    std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::condition_variable jobFinished;
+    bool isRunning = false;
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "BroadPhase.h"
+#include "Collider.h"
+
+//a stack of spatial hash grids, each level's cells twice the size of the level below. A collider goes to the
+//first level whose cells fit it, so a screen-sized trigger covers a handful of coarse cells while bullets share
+//small ones. Pairs within a level come from that level's grid, pairs across levels from the smaller collider
+//probing every coarser level
+class HierarchicalGrid : public BroadPhase
+{
+public:
+    static constexpr int MAX_LEVELS = 12;
+
+    [[nodiscard]] BroadPhaseType GetType() const override { return BroadPhaseType::HierarchicalGrid; }
+
+    void BeginFrame() override;
+
+    void Insert(Object* obj, const glm::vec2& boundsMin, const glm::vec2& boundsMax) override;
+
+    void Build() override;
+
+    void ComputePairs(std::vector<BroadPhasePair>& outPairs) override;
+
+    void QueryAABB(const glm::vec2& boundsMin, const glm::vec2& boundsMax, std::vector<Object*>& outObjects) override;
+
+    void Reset() override;
+
+    //0, the default, picks the finest cell size from the collider size histogram on every build
+    void SetBaseCellSize(int size) { fixedBaseCellSize = size; }
+    [[nodiscard]] int GetBaseCellSize() const { return baseCellSize; }
+    [[nodiscard]] int GetLevelCount() const { return levelCount; }
+
+private:
+    struct Entry
+    {
+        Object* object;
+        glm::vec2 boundsMin;
+        glm::vec2 boundsMax;
+    };
+
+    [[nodiscard]] int GetLevel(const Entry& entry) const;
+
+    std::vector<Entry> entries;
+    std::array<SpatialHashGrid, MAX_LEVELS> levels;
+    //entry indices per level, for the cross-level probes
+    std::array<std::vector<uint32_t>, MAX_LEVELS> levelEntries;
+    BoundsSizeHistogram sizeHistogram;
+    int levelCount = 0;
+    int baseCellSize = SpatialHashGrid::MIN_CELL_SIZE;
+    int fixedBaseCellSize = 0;
+    bool isBuilt = false;
+};
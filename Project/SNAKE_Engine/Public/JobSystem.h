@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class SNAKE_Engine;
+class FrameTaskGraph;
+class JobSystem;
+
+using JobFunction = std::function<void()>;
+using JobRangeFunction = std::function<void(size_t begin, size_t end)>;
+
+//refers to a scheduled job; stays valid after the job finishes
+class JobHandle
+{
+    friend JobSystem;
+public:
+    JobHandle() = default;
+
+    [[nodiscard]] bool IsValid() const { return job != nullptr; }
+
+    [[nodiscard]] bool IsDone() const;
+
+private:
+    struct Job;
+    explicit JobHandle(std::shared_ptr<Job> job_) : job(std::move(job_)) {}
+
+    std::shared_ptr<Job> job;
+};
+
+class JobSystem
+{
+    friend SNAKE_Engine;
+    friend FrameTaskGraph;
+public:
+    JobSystem() = default;
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    //runs on any worker once every dependency has finished
+    JobHandle Schedule(JobFunction function, const std::vector<JobHandle>& dependencies = {});
+
+    //runs on the main thread (during ExecuteMainThreadJobs or a main-thread Wait outside the frame graph and ParallelFor) once every dependency has finished
+    JobHandle ScheduleOnMainThread(JobFunction function, const std::vector<JobHandle>& dependencies = {});
+
+    //splits [0, count) into chunks of at least grainSize; the returned handle finishes after the last chunk
+    JobHandle ScheduleParallelFor(size_t count, size_t grainSize, JobRangeFunction body, const std::vector<JobHandle>& dependencies = {});
+
+    //blocking version; the calling thread works on chunks too
+    void ParallelFor(size_t count, size_t grainSize, const JobRangeFunction& body);
+
+    //executes other jobs while waiting instead of sleeping
+    void Wait(const JobHandle& handle);
+
+    void ExecuteMainThreadJobs();
+
+    [[nodiscard]] size_t GetWorkerCount() const { return workers.size(); }
+
+    [[nodiscard]] bool IsMainThread() const { return std::this_thread::get_id() == mainThreadID; }
+
+private:
+    void Init(unsigned int workerCount = 0);
+
+    void Shutdown();
+
+    JobHandle Submit(JobFunction function, const std::vector<JobHandle>& dependencies, bool isMainThreadOnly, bool isFrameStage = false);
+
+    //main thread stages of the frame graph get their own queue so waiting on the graph never runs game continuations
+    JobHandle ScheduleFrameStage(JobFunction function, const std::vector<JobHandle>& dependencies);
+
+    void WaitForFrameStage(const JobHandle& handle);
+
+    //only helps with worker jobs, so ParallelFor never runs game continuations while its chunks are in flight
+    void WaitForWorkerJobs(const JobHandle& handle);
+
+    void Enqueue(const std::shared_ptr<JobHandle::Job>& job);
+
+    [[nodiscard]] std::shared_ptr<JobHandle::Job> TryTakeJob(size_t queueIndex);
+
+    void Execute(const std::shared_ptr<JobHandle::Job>& job);
+
+    [[nodiscard]] bool TryExecuteMainThreadJob();
+
+    [[nodiscard]] bool TryExecuteFrameStageJob();
+
+    void WorkerLoop(size_t queueIndex);
+
+    [[nodiscard]] size_t GetCurrentQueueIndex() const;
+
+    //one deque per worker plus one for the main thread; owners pop the back, thieves take the front
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<JobHandle::Job>> jobs;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+
+    std::mutex mainThreadMutex;
+    std::vector<std::shared_ptr<JobHandle::Job>> mainThreadJobs;
+    std::vector<std::shared_ptr<JobHandle::Job>> frameStageJobs;
+
+    std::mutex sleepMutex;
+    std::condition_variable jobAvailable;
+    std::atomic<size_t> queuedJobCount = 0;
+    std::atomic<bool> isRunning = false;
+
+    std::thread::id mainThreadID = std::this_thread::get_id();
+};
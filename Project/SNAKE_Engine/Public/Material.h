@@ -4,6 +4,8 @@
 #include <variant>
 #include "glm.hpp"
 
+#include "StringID.h"
+
 class RenderManager;
 class ObjectManager;
 class Shader;
@@ -27,11 +29,21 @@ public:
     Material(Shader* _shader) : shader(_shader), isInstancingEnabled(false){}
 
     void SetTexture(const std::string& uniformName, Texture* texture)
+    {
+        SetTexture(StringID(uniformName), texture);
+    }
+
+    void SetTexture(StringID uniformName, Texture* texture)
     {
         textures[uniformName] = texture;
     }
 
     void SetUniform(const std::string& name, UniformValue value)
+    {
+        SetUniform(StringID(name), value);
+    }
+
+    void SetUniform(StringID name, UniformValue value)
     {
         uniforms[name] = value;
     }
@@ -56,8 +68,8 @@ private:
     [[nodiscard]] Shader* GetShader() const { return shader; }
 
     Shader* shader;
-    std::unordered_map<std::string, Texture*> textures;
-    std::unordered_map<std::string, UniformValue> uniforms;
+    std::unordered_map<StringID, Texture*> textures;
+    std::unordered_map<StringID, UniformValue> uniforms;
 
 
     bool isInstancingEnabled;
@@ -1,11 +1,13 @@
 #pragma once
 #include <vector>
 #include "Material.h"
+#include "VertexLayout.h"
 
 class ObjectManager;
+class MeshArena;
+class DynamicMesh;
 
-using GLuint = unsigned int;
-using GLsizei = int;
+using GLint = int;
 
 enum class PrimitiveType
 {
@@ -17,24 +19,29 @@ enum class PrimitiveType
     LineStrip
 };
 
-struct Vertex
-{
-    glm::vec3 position;
-    glm::vec2 uv;
-};
-
 class Mesh {
     friend Material;
     friend RenderManager;
+    friend MeshArena;
+    friend DynamicMesh;
 
 public:
-    Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices = {}, PrimitiveType primitiveType = PrimitiveType::Triangles);
+    Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices = {}, PrimitiveType primitiveType = PrimitiveType::Triangles, const VertexLayout& layout = {});
 
-    ~Mesh();
+    virtual ~Mesh();
 
     [[nodiscard]] glm::vec2 GetLocalBoundsHalfSize() const { return localHalfSize; }
 
+    [[nodiscard]] const VertexLayout& GetLayout() const { return layout; }
+
+protected:
+    Mesh(PrimitiveType primitiveType, const VertexLayout& layout);
+
 private:
+    Mesh(MeshArena& arena, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, PrimitiveType primitiveType);
+
+    [[nodiscard]] bool IsArenaBacked() const { return arena != nullptr; }
+
     void BindVAO(bool instanced) const;
 
     void SetupInstanceAttributes();
@@ -83,6 +90,14 @@ private:
     GLuint instanceVBO[4];
 
     bool useIndex;
+    bool useShortIndex = false;
+    VertexLayout layout;
+
+    //arena-backed meshes own no GL objects; they draw a sub-range of the arena's shared buffers
+    MeshArena* arena = nullptr;
+    GLint baseVertex = 0;
+    GLsizei vertexCount = 0;
+    GLuint indexByteOffset = 0;
 
     PrimitiveType primitiveType;
     glm::vec2 localHalfSize;
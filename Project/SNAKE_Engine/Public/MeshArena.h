@@ -0,0 +1,72 @@
+#pragma once
+#include <vector>
+
+#include "Mesh.h"
+
+class RenderManager;
+
+struct MeshArenaRange
+{
+    GLint baseVertex = 0;
+    GLsizei vertexCount = 0;
+    //index storage is allocated in 4-byte slots so 16-bit and 32-bit index ranges stay aligned
+    GLuint firstIndexSlot = 0;
+    GLsizei indexSlotCount = 0;
+    GLsizei indexCount = 0;
+    bool useShortIndex = false;
+};
+
+struct MeshArenaBlock
+{
+    GLsizei offset;
+    GLsizei count;
+};
+
+class MeshArena
+{
+    friend RenderManager;
+    friend Mesh;
+public:
+    explicit MeshArena(const VertexLayout& layout_) : layout(layout_) {}
+    ~MeshArena();
+
+    MeshArena(const MeshArena&) = delete;
+    MeshArena& operator=(const MeshArena&) = delete;
+
+    [[nodiscard]] GLsizei GetVertexCapacity() const { return vertexCapacity; }
+
+    [[nodiscard]] GLsizei GetIndexCapacity() const { return indexCapacity; }
+
+    [[nodiscard]] const VertexLayout& GetLayout() const { return layout; }
+
+private:
+    void Init(GLsizei initialVertexCapacity = 16384, GLsizei initialIndexSlotCapacity = 32768);
+
+    void Shutdown();
+
+    [[nodiscard]] bool Allocate(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, MeshArenaRange& out);
+
+    void Free(const MeshArenaRange& range);
+
+    void GrowVertexBuffer(GLsizei minFreeCount);
+
+    void GrowIndexBuffer(GLsizei minFreeCount);
+
+    void SetupVertexArrays();
+
+    void UpdateInstanceBuffer(const std::vector<glm::mat4>& transforms, const std::vector<glm::vec4>& colors, const std::vector<glm::vec2>& uvOffsets, const std::vector<glm::vec2>& uvScales) const;
+
+    VertexLayout layout;
+
+    GLuint vao = 0;
+    GLuint instanceVAO = 0;
+    GLuint vbo = 0;
+    GLuint ebo = 0;
+    GLuint instanceVBO[4] = { 0, 0, 0, 0 };
+
+    GLsizei vertexCapacity = 0;
+    GLsizei indexCapacity = 0;
+
+    std::vector<MeshArenaBlock> freeVertices;
+    std::vector<MeshArenaBlock> freeIndices;
+};
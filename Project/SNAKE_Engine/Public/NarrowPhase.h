@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+
+#include "BroadPhase.h"
+#include "ObjectComponentStore.h"
+
+class ObjectManager;
+
+//candidate pairs are sorted into one bucket per shape combination with both shapes stored column by column,
+//then tested eight at a time with AVX2 when the CPU supports it and one at a time otherwise
+class NarrowPhase
+{
+    friend ObjectManager;
+private:
+    enum BucketKind
+    {
+        CIRCLE_CIRCLE,
+        AABB_AABB,
+        //the circle is always on the a side
+        CIRCLE_AABB,
+        BUCKET_COUNT
+    };
+
+    struct PairBucket
+    {
+        std::vector<Object*> objectA;
+        std::vector<Object*> objectB;
+        std::vector<float> centerAX;
+        std::vector<float> centerAY;
+        std::vector<float> extentAX;
+        std::vector<float> extentAY;
+        std::vector<float> centerBX;
+        std::vector<float> centerBY;
+        std::vector<float> extentBX;
+        std::vector<float> extentBY;
+
+        void Clear();
+        void Push(Object* a, const ColliderShape& shapeA, Object* b, const ColliderShape& shapeB);
+    };
+
+    void Clear();
+    void Add(Object* a, const ColliderShape& shapeA, Object* b, const ColliderShape& shapeB);
+    //appends every pair whose shapes touch, in bucket order
+    void Run(std::vector<BroadPhasePair>& outContacts) const;
+
+    PairBucket buckets[BUCKET_COUNT];
+};
@@ -5,17 +5,43 @@
 #include "Animation.h"
 #include "Collider.h"
 #include "Mesh.h"
+#include "ObjectHandle.h"
+#include "StringID.h"
 #include "Transform.h"
 class FrustumCuller;
+class ObjectComponentStore;
+class ObjectPoolBase;
 struct EngineContext;
 enum class ObjectType
 {
     GAME,
     TEXT
 };
+enum class UpdatePolicy : uint8_t
+{
+    EveryFrame,
+    //Update runs every updateInterval frames with the dt accumulated since the last run
+    Interval,
+    //Update and animation pause while the last cull found the object off-screen
+    WhenVisible
+};
+enum CollisionEvent : uint8_t
+{
+    //OnCollision, every frame the colliders touch
+    COLLISION_EVENT_OVERLAP = 1 << 0,
+    COLLISION_EVENT_ENTER = 1 << 1,
+    //every touching frame after the first
+    COLLISION_EVENT_STAY = 1 << 2,
+    COLLISION_EVENT_EXIT = 1 << 3,
+    COLLISION_EVENT_DEFAULT = COLLISION_EVENT_OVERLAP | COLLISION_EVENT_ENTER | COLLISION_EVENT_EXIT
+};
 class Object
 {
     friend FrustumCuller;
+    friend ObjectManager;
+    friend ObjectComponentStore;
+    friend ObjectPoolBase;
+    friend Collider;
 public:
     Object() = delete;
     virtual void Init([[maybe_unused]] const EngineContext& engineContext) = 0;
@@ -34,6 +60,18 @@ public:
 
     virtual void OnCollision(Object* other) {}
 
+    virtual void OnCollisionEnter(Object* other) {}
+
+    virtual void OnCollisionStay(Object* other) {}
+
+    //also sent when either object dies while touching
+    virtual void OnCollisionExit(Object* other) {}
+
+    //pooled objects skip Init/Free when recycled; these hooks reset per-spawn state instead
+    virtual void OnAcquire() {}
+
+    virtual void OnRelease() {}
+
     [[nodiscard]] const bool& IsAlive() const;
 
     [[nodiscard]] const bool& IsVisible() const;
@@ -41,21 +79,28 @@ public:
 
     void Kill();
 
+    //ObjectManager indexes objects by the tag they were added with
     void SetTag(const std::string& tag);
     [[nodiscard]] const std::string& GetTag() const;
+    [[nodiscard]] StringID GetTagID() const { return objectTagID; }
 
     [[nodiscard]] const std::string& GetRenderLayerTag() const;
+    [[nodiscard]] StringID GetRenderLayerTagID() const { return renderLayerTagID; }
     void SetRenderLayer(const std::string& tag);
 
     void SetMaterial(const EngineContext& engineContext, const std::string& tag);
 
-    void SetMaterial(Material* material_) { material = material_; }
+    void SetMaterial(const EngineContext& engineContext, StringID tag);
+
+    void SetMaterial(Material* material_);
 
     [[nodiscard]] Material* GetMaterial() const;
 
     void SetMesh(const EngineContext& engineContext, const std::string& tag);
 
-    void SetMesh(Mesh* mesh_) { mesh = mesh_; }
+    void SetMesh(const EngineContext& engineContext, StringID tag);
+
+    void SetMesh(Mesh* mesh_);
 
     [[nodiscard]] Mesh* GetMesh() const;
 
@@ -73,29 +118,51 @@ public:
 
     [[nodiscard]] virtual SpriteAnimator* GetSpriteAnimator() const { return spriteAnimator.get(); }
 
-    void AttachAnimator(std::unique_ptr<SpriteAnimator> anim) { spriteAnimator = std::move(anim); }
-    void AttachAnimator(SpriteSheet* sheet, float frameTime, bool loop = true) { spriteAnimator = std::make_unique<SpriteAnimator>(sheet, frameTime, loop); }
-    void DetachAnimator() { spriteAnimator = nullptr; }
+    void AttachAnimator(std::unique_ptr<SpriteAnimator> anim);
+    void AttachAnimator(SpriteSheet* sheet, float frameTime, bool loop = true) { AttachAnimator(std::make_unique<SpriteAnimator>(sheet, frameTime, loop)); }
+    void DetachAnimator() { AttachAnimator(nullptr); }
 
-    void SetCollider(std::unique_ptr<Collider> c) { collider = std::move(c); }
+    void SetCollider(std::unique_ptr<Collider> c);
     [[nodiscard]] Collider* GetCollider() const { return collider.get(); }
     void SetCollision(ObjectManager& objectManager, const std::string& tag, const std::vector<std::string>& checkCollisionList);
 
     [[nodiscard]] uint32_t GetCollisionMask() const { return collisionMask; }
     [[nodiscard]] uint32_t GetCollisionCategory() const { return collisionCategory; }
 
+    //CollisionEvent bits; objects that only listen for enter and exit cost nothing while a contact persists
+    void SetCollisionEvents(uint8_t events) { collisionEvents = events; }
+    [[nodiscard]] uint8_t GetCollisionEvents() const { return collisionEvents; }
+
     [[nodiscard]] bool ShouldIgnoreCamera() const;
     void SetIgnoreCamera(bool shouldIgnoreCamera, Camera2D* cameraForTransformCalc = nullptr);
 
     [[nodiscard]] ObjectType GetType() const { return type; }
 
+    //ObjectManager keeps one bucket per policy, so objects that are not due cost nothing per frame
+    void SetUpdatePolicy(UpdatePolicy policy, uint32_t frameInterval = 1);
+    [[nodiscard]] UpdatePolicy GetUpdatePolicy() const { return updatePolicy; }
+    [[nodiscard]] uint32_t GetUpdateInterval() const { return updateInterval; }
+
+    //no Update, animation or collider sync until WakeUp, a collision, or wakeAfterSeconds (when > 0)
+    void Sleep(float wakeAfterSeconds = 0.f);
+    void WakeUp();
+    [[nodiscard]] bool IsAsleep() const { return isAsleep; }
+
+    //opt-in for ObjectManager's parallel update; Update may then only touch this object's own state
+    //and must not change its update policy or sleep state
+    void SetThreadSafeUpdate(bool isThreadSafe) { isThreadSafeUpdate = isThreadSafe; }
+    [[nodiscard]] bool IsThreadSafeUpdate() const { return isThreadSafeUpdate; }
+
+    //stays valid to hold after the object is erased; resolve it through ObjectManager::Get
+    [[nodiscard]] ObjectHandle GetHandle() const { return handle; }
+
     [[nodiscard]] Camera2D* GetReferenceCamera() const { return referenceCamera; }
 
     [[nodiscard]] virtual glm::vec2 GetWorldPosition() const;
     [[nodiscard]] virtual glm::vec2 GetWorldScale() const;
 
-    void SetFlipUV_X(bool shouldFlip) { flipUV_X = shouldFlip; }
-    void SetFlipUV_Y(bool shouldFlip) { flipUV_Y = shouldFlip; }
+    void SetFlipUV_X(bool shouldFlip);
+    void SetFlipUV_Y(bool shouldFlip);
     [[nodiscard]] glm::vec2 GetUVFlipVector() const;
 
 protected:
@@ -104,6 +171,8 @@ protected:
 
     [[nodiscard]] virtual float GetBoundingRadius() const;
 
+    //while the object sits in an ObjectManager its per-frame state lives in the manager's component store;
+    //change the members below through their setters so the store row stays in sync
     bool isAlive = true;
     bool isVisible = true;
 
@@ -112,6 +181,8 @@ protected:
 
     std::string objectTag;
     std::string renderLayerTag;
+    StringID objectTagID;
+    StringID renderLayerTagID;
 
     Transform2D transform2D;
     Material* material = nullptr;
@@ -125,7 +196,30 @@ protected:
    
     uint32_t collisionCategory = 0;
     uint32_t collisionMask = 0;
+    uint8_t collisionEvents = COLLISION_EVENT_DEFAULT;
 
     bool flipUV_X = false;
     bool flipUV_Y = false;
+
+    bool isThreadSafeUpdate = false;
+
+private:
+    void WriteUpdateFlags();
+    void SyncColliderRow();
+
+    ObjectHandle handle;
+    ObjectManager* ownerManager = nullptr;
+    ObjectPoolBase* ownerPool = nullptr;
+    bool isPoolInitialized = false;
+    size_t objectIndex = 0;
+    size_t rawPtrIndex = 0;
+    size_t tagIndexSlot = 0;
+
+    UpdatePolicy updatePolicy = UpdatePolicy::EveryFrame;
+    uint32_t updateInterval = 1;
+    bool isAsleep = false;
+    uint32_t sleepGeneration = 0;
+    bool isInUpdateTier = false;
+    uint32_t updateTierPhase = 0;
+    size_t updateTierSlot = 0;
 };
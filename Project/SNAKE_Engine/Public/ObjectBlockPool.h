@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class Object;
+
+class ObjectBlockPool
+{
+public:
+    ObjectBlockPool(size_t blockSize, size_t blockAlign, size_t firstChunkBlocks = 32);
+    ~ObjectBlockPool();
+
+    ObjectBlockPool(const ObjectBlockPool&) = delete;
+    ObjectBlockPool& operator=(const ObjectBlockPool&) = delete;
+
+    [[nodiscard]] void* Allocate();
+
+    void Deallocate(void* block);
+
+    [[nodiscard]] size_t GetLiveCount() const { return liveCount; }
+
+    [[nodiscard]] size_t GetCapacity() const { return capacity; }
+
+private:
+    struct FreeNode
+    {
+        FreeNode* next;
+    };
+
+    void AddChunk();
+
+    size_t blockSize;
+    size_t blockAlign;
+    size_t nextChunkBlocks;
+
+    std::vector<void*> chunks;
+    FreeNode* freeList = nullptr;
+
+    size_t liveCount = 0;
+    size_t capacity = 0;
+};
+
+//returns pooled objects to their block instead of the global heap
+struct ObjectDeleter
+{
+    ObjectBlockPool* pool = nullptr;
+
+    void operator()(Object* obj) const;
+};
+
+using ObjectPtr = std::unique_ptr<Object, ObjectDeleter>;
@@ -0,0 +1,141 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "glm.hpp"
+
+class Object;
+class Transform2D;
+class Mesh;
+class Material;
+class SpriteAnimator;
+class Collider;
+class JobSystem;
+class ObjectManager;
+class RenderManager;
+class FrustumCuller;
+class ObjectComponentStore;
+enum class ColliderType;
+
+struct ComponentRow
+{
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    ObjectComponentStore* store = nullptr;
+    uint32_t index = INVALID_INDEX;
+
+    [[nodiscard]] bool IsBound() const { return store != nullptr; }
+};
+
+struct ComponentBounds
+{
+    glm::vec2 min = glm::vec2(0.f);
+    glm::vec2 max = glm::vec2(0.f);
+};
+
+//world-space narrow phase shape; extent is the half size of an AABB or the radius, twice, of a circle
+struct ColliderShape
+{
+    glm::vec2 center = glm::vec2(0.f);
+    glm::vec2 extent = glm::vec2(0.f);
+    ColliderType type{};
+};
+
+//dense per-object columns for the per-frame engine passes; a bound Object and its Transform2D read and write through their row
+class ObjectComponentStore
+{
+    friend ObjectManager;
+    friend RenderManager;
+    friend FrustumCuller;
+    friend Object;
+    friend Transform2D;
+public:
+    static constexpr uint8_t UNRESOLVED_LAYER = UINT8_MAX;
+    static constexpr size_t PARALLEL_GRAIN_SIZE = 256;
+
+    enum RowFlag : uint8_t
+    {
+        ROW_ALIVE = 1 << 0,
+        ROW_VISIBLE = 1 << 1,
+        ROW_IGNORE_CAMERA = 1 << 2,
+        //text and screen-space objects derive their world bounds virtually
+        ROW_CUSTOM_BOUNDS = 1 << 3,
+        ROW_ASLEEP = 1 << 4,
+        //not UpdatePolicy::EveryFrame; ObjectManager steps the animator when the object is due
+        ROW_TIERED_UPDATE = 1 << 5,
+        ROW_STATIC_COLLIDER = 1 << 6
+    };
+
+    ObjectComponentStore() = default;
+    ObjectComponentStore(const ObjectComponentStore&) = delete;
+    ObjectComponentStore& operator=(const ObjectComponentStore&) = delete;
+
+    [[nodiscard]] size_t GetSize() const { return owners.size(); }
+
+    [[nodiscard]] Object* GetOwner(uint32_t row) const { return owners[row]; }
+
+    [[nodiscard]] const std::vector<glm::vec2>& GetPositions() const { return positions; }
+
+    [[nodiscard]] const std::vector<glm::vec2>& GetScales() const { return scales; }
+
+    [[nodiscard]] const std::vector<ComponentBounds>& GetColliderBounds() const { return colliderBounds; }
+
+    [[nodiscard]] const std::vector<ColliderShape>& GetColliderShapes() const { return colliderShapes; }
+
+    //true if a cull since the last ObjectManager update found the row on screen
+    [[nodiscard]] bool WasVisible(uint32_t row) const { return visibleFrames[row] == visibilityFrame; }
+
+private:
+    void Bind(Object* obj);
+    void Unbind(Object* obj);
+    void Clear();
+    void Reserve(size_t capacity);
+
+    //rows are independent, so both split across jobSystem's workers when one is given
+    void UpdateAnimators(float dt, JobSystem* jobSystem = nullptr);
+    void UpdateAnimator(uint32_t row, float dt);
+    void SyncColliders(JobSystem* jobSystem = nullptr);
+    void SyncCollider(size_t row);
+    //true once after any static collider was resynced
+    [[nodiscard]] bool ConsumeStaticCollidersChanged() { return staticCollidersChanged.exchange(false, std::memory_order_relaxed); }
+
+    void MarkVisible(const std::vector<uint32_t>& rows);
+    void AdvanceVisibilityFrame() { ++visibilityFrame; }
+
+    [[nodiscard]] glm::mat4& GetMatrix(uint32_t row);
+    [[nodiscard]] static uint8_t MakeFlags(const Object& obj);
+    [[nodiscard]] static uint8_t MakeUpdateFlags(const Object& obj);
+    void WriteBack(uint32_t row);
+
+    std::vector<Object*> owners;
+
+    std::vector<glm::vec2> positions;
+    std::vector<float> rotations;
+    std::vector<glm::vec2> scales;
+    std::vector<glm::mat4> matrices;
+    std::vector<uint8_t> matrixDirty;
+
+    std::vector<glm::vec4> colors;
+    std::vector<glm::vec2> uvFlips;
+    std::vector<uint8_t> flags;
+    std::vector<uint8_t> renderLayers;
+    std::vector<Mesh*> meshes;
+    std::vector<Material*> materials;
+
+    std::vector<SpriteAnimator*> animators;
+    std::vector<glm::vec2> uvOffsets;
+    std::vector<glm::vec2> uvScales;
+
+    std::vector<Collider*> colliders;
+    std::vector<ComponentBounds> colliderBounds;
+    std::vector<ColliderShape> colliderShapes;
+    //set when the transform or collider changes; sleeping and static rows only resync when it is set
+    std::vector<uint8_t> colliderDirty;
+    std::atomic<bool> staticCollidersChanged = false;
+
+    std::vector<uint32_t> visibleFrames;
+    uint32_t visibilityFrame = 1;
+
+    uint32_t renderLayerVersion = 0;
+};
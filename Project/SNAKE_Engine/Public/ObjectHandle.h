@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+
+struct ObjectHandle
+{
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    [[nodiscard]] bool IsValid() const { return index != INVALID_INDEX; }
+
+    bool operator==(const ObjectHandle& other) const
+    {
+        return index == other.index && generation == other.generation;
+    }
+
+    bool operator!=(const ObjectHandle& other) const { return !(*this == other); }
+};
+
+namespace std
+{
+    template<>
+    struct hash<ObjectHandle>
+    {
+        std::size_t operator()(const ObjectHandle& handle) const noexcept
+        {
+            return std::hash<uint64_t>()((static_cast<uint64_t>(handle.generation) << 32) | handle.index);
+        }
+    };
+}
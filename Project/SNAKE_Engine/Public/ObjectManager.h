@@ -1,47 +1,341 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <unordered_map>
 #include <string>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <new>
+#include <queue>
+#include <tuple>
+#include <typeindex>
+#include <type_traits>
 
+#include "ObjectBlockPool.h"
+#include "NarrowPhase.h"
+#include "ObjectComponentStore.h"
+#include "ObjectHandle.h"
+#include "ObjectPool.h"
+#include "ObjectQuery.h"
+#include "Prefab.h"
 #include "RenderManager.h"
 
 class GameState;
 class Object;
 struct EngineContext;
 class Camera2D;
+class JobSystem;
+
+struct RaycastHit
+{
+    Object* object = nullptr;
+    glm::vec2 point = glm::vec2(0.f);
+    glm::vec2 normal = glm::vec2(0.f);
+    float distance = 0.f;
+};
 
 class ObjectManager
 {
     friend GameState;
+    friend Object;
+    friend ObjectPoolBase;
 public:
     [[maybe_unused]]Object* AddObject(std::unique_ptr<Object> obj, const std::string& tag = "");
+
+    //constructs T in a per-type block pool instead of a separate heap allocation
+    template<typename T, typename... Args>
+    [[maybe_unused]] T* Create(const std::string& tag, Args&&... args)
+    {
+        ObjectPtr obj = Construct<T>(std::forward<Args>(args)...);
+        T* returnVal = static_cast<T*>(obj.get());
+        AddObject(std::move(obj), tag);
+        return returnVal;
+    }
+
+    //pre-warms prewarmCount instances through Init/LateInit; killed instances are parked in the pool instead of destroyed
+    template<typename T, typename... Args>
+    [[nodiscard]] ObjectPool<T>* CreatePool(const EngineContext& engineContext, const std::string& tag, size_t prewarmCount, Args... args)
+    {
+        std::unique_ptr<ObjectPool<T>> pool(new ObjectPool<T>(*this, tag, [this, args...]() { return Construct<T>(args...); }));
+        ObjectPool<T>* returnVal = pool.get();
+        objectPools.push_back(std::move(pool));
+        returnVal->Prewarm(engineContext, prewarmCount);
+        return returnVal;
+    }
+
+    //spawns count instances of T sharing prefab's setup; argsFor(i) returns a std::tuple of T's constructor
+    //arguments and initializer(T&, i) applies per-instance state. Storage is reserved and tags resolved once
+    template<typename T, typename ArgsFor, typename Initializer>
+    std::vector<T*> InstantiateBatch(const EngineContext& engineContext, const Prefab& prefab, size_t count, ArgsFor&& argsFor, Initializer&& initializer)
+    {
+        const ResolvedPrefab resolved = ResolvePrefab(engineContext, prefab);
+        ReserveForBatch(count, resolved.tagID);
+
+        std::vector<T*> result;
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            ObjectPtr obj = std::apply([this](auto&&... args) { return Construct<T>(std::forward<decltype(args)>(args)...); }, argsFor(i));
+            T* instance = static_cast<T*>(obj.get());
+            ApplyPrefab(*instance, prefab, resolved);
+            initializer(*instance, i);
+            Register(std::move(obj), prefab.tag, resolved.tagID);
+            result.push_back(instance);
+        }
+
+        if (!result.empty() && resolved.tagID.IsValid())
+            objectMap[resolved.tagID] = result.back()->GetHandle();
+        return result;
+    }
+
+    template<typename T, typename Initializer>
+    std::vector<T*> InstantiateBatch(const EngineContext& engineContext, const Prefab& prefab, size_t count, Initializer&& initializer)
+    {
+        return InstantiateBatch<T>(engineContext, prefab, count, [](size_t) { return std::tuple<>(); }, std::forward<Initializer>(initializer));
+    }
+
     void InitAll(const EngineContext& engineContext);
     void UpdateAll(float dt, const EngineContext& engineContext);
+
+    //objects marked SetThreadSafeUpdate run their Update on the job system before the serial ones
+    void SetParallelUpdate(bool shouldUseParallel) { isParallelUpdate = shouldUseParallel; }
+    [[nodiscard]] bool IsParallelUpdate() const { return isParallelUpdate; }
     void DrawAll(const EngineContext& engineContext);
+    //culls ahead of DrawAll; safe to run off the main thread while nothing mutates the objects
+    void PrepareDraw(const EngineContext& engineContext);
     void DrawObjects(const EngineContext& engineContext, const std::vector<Object*>& objects);
     void DrawObjectsWithTag(const EngineContext& engineContext, const std::string& tag);
 
     void FreeAll(const EngineContext& engineContext);
 
+    //returns nullptr once the object behind the handle has died or been erased
+    [[nodiscard]] Object* Get(ObjectHandle handle) const;
+
     [[nodiscard]] Object* FindByTag(const std::string& tag) const;
+    [[nodiscard]] Object* FindByTag(StringID tag) const;
     void FindByTag(const std::string& tag, std::vector<Object*>& result);
+    void FindByTag(StringID tag, std::vector<Object*>& result);
+
+    //iterate without copying, e.g. for (Object* obj : Query().WithCollider())
+    [[nodiscard]] ObjectQuery Query() const { return ObjectQuery(rawPtrObjects); }
+    [[nodiscard]] ObjectQuery Query(StringID tag) const;
     void CheckCollision();
 
+    //the spatial hash grid suits many similar-sized movers, the hierarchical grid movers of very different sizes,
+    //the tree mostly static or mixed-size scenes, sweep and prune scenes spread along one axis
+    void SetBroadPhase(BroadPhaseType type);
+    [[nodiscard]] BroadPhaseType GetBroadPhaseType() const { return broadPhaseType; }
+
+    static constexpr uint32_t QUERY_ALL_CATEGORIES = UINT32_MAX;
+
+    //immediate queries over the colliders as of the last CheckCollision, answered by the broad phase.
+    //They append to the caller's buffer and return how many objects they added; collisionMask keeps objects
+    //whose collision category it contains, QUERY_ALL_CATEGORIES also keeps objects without a group
+    size_t QueryAABB(const glm::vec2& boundsMin, const glm::vec2& boundsMax, std::vector<Object*>& outObjects, uint32_t collisionMask = QUERY_ALL_CATEGORIES);
+    size_t QueryCircle(const glm::vec2& center, float radius, std::vector<Object*>& outObjects, uint32_t collisionMask = QUERY_ALL_CATEGORIES);
+    //tests the live position through Collider::CheckPointCollision
+    size_t QueryPoint(const glm::vec2& point, std::vector<Object*>& outObjects, uint32_t collisionMask = QUERY_ALL_CATEGORIES);
+    //closest hit within maxDistance; a ray starting inside a collider hits it at distance 0
+    bool Raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, RaycastHit& outHit, uint32_t collisionMask = QUERY_ALL_CATEGORIES);
+    //up to k objects by distance from point to their collider, closest first
+    size_t FindNearest(const glm::vec2& point, size_t k, std::vector<Object*>& outObjects, uint32_t collisionMask = QUERY_ALL_CATEGORIES,
+        float maxDistance = std::numeric_limits<float>::max());
+
+    [[nodiscard]] uint32_t MakeCollisionMask(const std::vector<std::string>& groups);
+
     [[nodiscard]] CollisionGroupRegistry& GetCollisionGroupRegistry() { return collisionGroupRegistry; }
 
-    [[nodiscard]] std::vector<Object*> GetAllRawPtrObjects() { return rawPtrObjects; }
+    [[nodiscard]] const std::vector<Object*>& GetAllRawPtrObjects() const { return rawPtrObjects; }
+
+    [[nodiscard]] const ObjectComponentStore& GetComponentStore() const { return componentStore; }
 
 private:
+    template<typename T, typename... Args>
+    [[nodiscard]] ObjectPtr Construct(Args&&... args)
+    {
+        static_assert(std::is_base_of_v<Object, T>, "T must derive from Object");
+
+        ObjectBlockPool& pool = GetBlockPool(typeid(T), sizeof(T), alignof(T));
+        void* block = pool.Allocate();
+        T* obj = nullptr;
+        try
+        {
+            obj = new (block) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            pool.Deallocate(block);
+            throw;
+        }
+        return ObjectPtr(obj, ObjectDeleter{ &pool });
+    }
+
+    Object* AddObject(ObjectPtr obj, const std::string& tag);
+    //everything AddObject does except the objectMap entry
+    Object* Register(ObjectPtr obj, const std::string& tag, StringID tagID);
+    //AddObject for a pool's spawns: the tag is already resolved, and pooled objects share it by design, so no duplicate warning
+    Object* AddPooledObject(ObjectPtr obj, const std::string& tag, StringID tagID);
+
+    struct ResolvedPrefab
+    {
+        StringID tagID;
+        StringID renderLayerID;
+        Mesh* mesh = nullptr;
+        Material* material = nullptr;
+        SpriteSheet* spriteSheet = nullptr;
+        StringID animationClip;
+        uint32_t collisionCategory = 0;
+        uint32_t collisionMask = 0;
+    };
+
+    [[nodiscard]] ResolvedPrefab ResolvePrefab(const EngineContext& engineContext, const Prefab& prefab);
+    void ApplyPrefab(Object& obj, const Prefab& prefab, const ResolvedPrefab& resolved);
+    void ReserveForBatch(size_t count, StringID tagID);
+    [[nodiscard]] ObjectBlockPool& GetBlockPool(std::type_index type, size_t size, size_t align);
     void AddAllPendingObjects(const EngineContext& engineContext);
     void EraseDeadObjects(const EngineContext& engineContext);
     void DrawColliderDebug(RenderManager* rm, Camera2D* cam);
+    void RebuildStaticColliders();
+    void RebuildCategoryInteractions();
+    void AddCrossBucketPairs(size_t bucketA, size_t bucketB);
+
+    //diffs this frame's sorted contacts against last frame's and sends enter, stay and exit
+    void DispatchContacts();
+    //false when the pair was skipped, so it stays out of the contact cache
+    bool DispatchContact(Object* a, Object* b, bool isStaying);
+    void DispatchExit(Object* a, Object* b);
+    void DispatchExitsForDeadObjects();
+
+    //fills queryCandidates with the live, mask-matching colliders whose bounds overlap
+    void CollectQueryCandidates(const glm::vec2& boundsMin, const glm::vec2& boundsMax, uint32_t collisionMask);
+    [[nodiscard]] const ColliderShape& GetColliderShape(const Object* obj) const { return componentStore.colliderShapes[obj->transform2D.row.index]; }
+
+    void AddToTagIndex(Object* obj);
+    //moves a registered object's tagIndex and objectMap entries to the new tag
+    void Retag(Object* obj, const std::string& tag);
+    //pending or live, including killed objects that are not erased yet; parked pool objects are not
+    [[nodiscard]] bool IsRegistered(const Object* obj) const;
+    void RemoveFromTagIndex(Object* obj);
+
+    void RefreshUpdateTier(Object* obj);
+    void AddToUpdateTier(Object* obj);
+    void RemoveFromUpdateTier(Object* obj);
+    void ScheduleWakeUp(Object* obj, float wakeAfterSeconds);
+    void WakeTimedSleepers();
+    void CollectDueUpdates(float dt);
+    [[nodiscard]] bool ShouldUpdateInParallel(const Object* obj) const;
+
+    [[nodiscard]] ObjectHandle AllocateHandle(Object* obj);
+    void ReleaseHandle(ObjectHandle handle);
 
-    std::vector<std::unique_ptr<Object>> objects;
-    std::vector<std::unique_ptr<Object>> pendingObjects;
-    std::unordered_map<std::string, Object*> objectMap;
+    struct ObjectSlot
+    {
+        Object* object = nullptr;
+        uint32_t generation = 0;
+    };
+
+    std::vector<ObjectSlot> slots;
+    std::vector<uint32_t> freeSlots;
+
+    //declared before the object lists so pooled objects are destroyed before their storage
+    std::unordered_map<std::type_index, std::unique_ptr<ObjectBlockPool>> blockPools;
+    std::vector<std::unique_ptr<ObjectPoolBase>> objectPools;
+
+    std::vector<ObjectPtr> objects;
+    std::vector<ObjectPtr> pendingObjects;
+    std::unordered_map<StringID, ObjectHandle> objectMap;
+    //every live or pending object per tag; objectMap only remembers the latest one
+    std::unordered_map<StringID, std::vector<Object*>> tagIndex;
     std::vector<Object*> rawPtrObjects;
-    SpatialHashGrid broadPhaseGrid;
+    ObjectComponentStore componentStore;
+
+    static constexpr size_t CATEGORY_COUNT = 32;
+    //colliders with no category or an empty mask can never pair, so they are only kept for queries
+    static constexpr size_t QUERY_ONLY_BUCKET = CATEGORY_COUNT;
+
+    //dynamic colliders grouped by the lowest bit of their category, each with its own broad phase
+    struct CategoryBucket
+    {
+        std::unique_ptr<BroadPhase> broadPhase;
+        std::vector<uint32_t> rows;
+        //unions over the bucket's colliders this frame
+        uint32_t categories = 0;
+        uint32_t masks = 0;
+    };
+
+    BroadPhaseType broadPhaseType = BroadPhaseType::SpatialHashGrid;
+    std::array<CategoryBucket, CATEGORY_COUNT + 1> categoryBuckets;
+    //bit j of row i is set when some collider of bucket i and some of bucket j accept each other;
+    //rebuilt only when a bucket's unions change
+    std::array<uint32_t, CATEGORY_COUNT> categoryInteractions{};
+    size_t dynamicColliderCount = 0;
+    //union of every dynamic and static collider's bounds as of the last CheckCollision
+    glm::vec2 colliderBoundsMin = glm::vec2(0.f);
+    glm::vec2 colliderBoundsMax = glm::vec2(0.f);
+    std::vector<BroadPhasePair> broadPhasePairs;
+    std::vector<Object*> crossBucketHits;
+    //static colliders are kept out of the buckets and only queried by the dynamic ones
+    SpatialHashGrid staticColliderGrid;
+    size_t staticColliderCount = 0;
+    uint32_t staticCategories = 0;
+    uint32_t staticMasks = 0;
+    NarrowPhase narrowPhase;
+    std::vector<BroadPhasePair> contacts;
+
+    struct ContactPair
+    {
+        //both handle indices, lower one in the high bits; unique while both objects live
+        uint64_t key;
+        Object* a;
+        Object* b;
+    };
+
+    //sorted by key; kept across frames
+    std::vector<ContactPair> contactCache;
+    std::vector<ContactPair> currentContacts;
+
+    std::vector<Object*> queryCandidates;
+    //the broad phases still point at these until the next CheckCollision, so queries must not dereference them
+    std::vector<Object*> erasedSinceCollision;
+    bool isErasedSorted = true;
+    std::vector<std::pair<float, Object*>> nearestCandidates;
     CollisionGroupRegistry collisionGroupRegistry;
+
+    struct IntervalTier
+    {
+        //objects are spread round-robin over the phases, so each frame touches only one of them
+        std::vector<std::vector<Object*>> phases;
+        std::vector<float> phaseLastUpdateTime;
+        uint32_t nextPhase = 0;
+    };
+
+    struct DueUpdate
+    {
+        Object* object;
+        float dt;
+    };
+
+    struct SleepTimer
+    {
+        float wakeTime;
+        ObjectHandle handle;
+        uint32_t sleepGeneration;
+
+        bool operator>(const SleepTimer& other) const { return wakeTime > other.wakeTime; }
+    };
+
+    //sleeping objects are in none of these
+    std::vector<Object*> everyFrameObjects;
+    std::vector<Object*> whenVisibleObjects;
+    std::unordered_map<uint32_t, IntervalTier> intervalTiers;
+    std::priority_queue<SleepTimer, std::vector<SleepTimer>, std::greater<>> sleepTimers;
+    std::vector<DueUpdate> dueUpdates;
+    float updateTime = 0.f;
+    uint64_t updateFrame = 0;
+
+    bool isParallelUpdate = false;
+    JobSystem* jobSystem = nullptr;
+    std::vector<DueUpdate> parallelUpdates;
 };
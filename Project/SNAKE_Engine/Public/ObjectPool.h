@@ -0,0 +1,58 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ObjectBlockPool.h"
+#include "StringID.h"
+
+class Object;
+class ObjectManager;
+struct EngineContext;
+
+class ObjectPoolBase
+{
+    friend ObjectManager;
+public:
+    virtual ~ObjectPoolBase() = default;
+
+    ObjectPoolBase(const ObjectPoolBase&) = delete;
+    ObjectPoolBase& operator=(const ObjectPoolBase&) = delete;
+
+    [[nodiscard]] size_t GetParkedCount() const { return parked.size(); }
+
+    [[nodiscard]] const std::string& GetTag() const { return tag; }
+
+protected:
+    ObjectPoolBase(ObjectManager& objectManager_, const std::string& tag_, std::function<ObjectPtr()> factory_)
+        : objectManager(&objectManager_), tag(tag_), tagID(tag_.empty() ? StringID() : StringID::Intern(tag_)), factory(std::move(factory_)) {}
+
+    [[nodiscard]] Object* AcquireObject();
+
+private:
+    void Prewarm(const EngineContext& engineContext, size_t count);
+
+    void Park(ObjectPtr obj);
+
+    void FreeParked(const EngineContext& engineContext);
+
+    ObjectManager* objectManager;
+    std::string tag;
+    //resolved once, so a spawn does no string work
+    StringID tagID;
+    std::function<ObjectPtr()> factory;
+    std::vector<ObjectPtr> parked;
+};
+
+template<typename T>
+class ObjectPool : public ObjectPoolBase
+{
+    friend ObjectManager;
+public:
+    //reuses a parked instance when one is available; a recycled object gets OnAcquire instead of Init/LateInit
+    [[nodiscard]] T* Acquire() { return static_cast<T*>(AcquireObject()); }
+
+private:
+    ObjectPool(ObjectManager& objectManager_, const std::string& tag_, std::function<ObjectPtr()> factory_)
+        : ObjectPoolBase(objectManager_, tag_, std::move(factory_)) {}
+};
@@ -0,0 +1,121 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "Object.h"
+
+//non-owning filtered view over an ObjectManager list; adding or erasing objects invalidates it
+class ObjectQuery
+{
+public:
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Object*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Object* const*;
+        using reference = Object*;
+
+        Iterator(const ObjectQuery* query_, size_t index_) : query(query_), index(index_) { SkipUnmatched(); }
+
+        [[nodiscard]] Object* operator*() const { return (*query->source)[index]; }
+
+        Iterator& operator++()
+        {
+            ++index;
+            SkipUnmatched();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator prev = *this;
+            ++*this;
+            return prev;
+        }
+
+        bool operator==(const Iterator& other) const { return index == other.index && query == other.query; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        void SkipUnmatched()
+        {
+            const std::vector<Object*>& list = *query->source;
+            while (index < list.size() && !query->Matches(list[index]))
+                ++index;
+        }
+
+        const ObjectQuery* query;
+        size_t index;
+    };
+
+    explicit ObjectQuery(const std::vector<Object*>& source_) : source(&source_) {}
+
+    [[nodiscard]] ObjectQuery OfType(ObjectType type_) const
+    {
+        ObjectQuery query = *this;
+        query.hasTypeFilter = true;
+        query.type = type_;
+        return query;
+    }
+
+    [[nodiscard]] ObjectQuery WithTag(StringID tag_) const
+    {
+        ObjectQuery query = *this;
+        query.tag = tag_;
+        return query;
+    }
+
+    [[nodiscard]] ObjectQuery WithCollider() const
+    {
+        ObjectQuery query = *this;
+        query.requireCollider = true;
+        return query;
+    }
+
+    [[nodiscard]] ObjectQuery WithAnimator() const
+    {
+        ObjectQuery query = *this;
+        query.requireAnimator = true;
+        return query;
+    }
+
+    [[nodiscard]] Iterator begin() const { return Iterator(this, 0); }
+    [[nodiscard]] Iterator end() const { return Iterator(this, source->size()); }
+
+    [[nodiscard]] size_t Count() const
+    {
+        size_t count = 0;
+        for (const Object* obj : *source)
+            if (Matches(obj))
+                ++count;
+        return count;
+    }
+
+    [[nodiscard]] bool IsEmpty() const { return begin() == end(); }
+
+private:
+    [[nodiscard]] bool Matches(const Object* obj) const
+    {
+        if (!obj->IsAlive())
+            return false;
+        if (hasTypeFilter && obj->GetType() != type)
+            return false;
+        if (tag.IsValid() && obj->GetTagID() != tag)
+            return false;
+        if (requireCollider && !obj->GetCollider())
+            return false;
+        if (requireAnimator && !obj->HasAnimation())
+            return false;
+        return true;
+    }
+
+    const std::vector<Object*>* source;
+    StringID tag;
+    ObjectType type = ObjectType::GAME;
+    bool hasTypeFilter = false;
+    bool requireCollider = false;
+    bool requireAnimator = false;
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "glm.hpp"
+
+class Object;
+class Collider;
+enum class UpdatePolicy : uint8_t;
+
+//shared setup for ObjectManager::InstantiateBatch; resource tags are resolved once per batch, empty fields are left alone
+struct Prefab
+{
+    std::string tag;
+
+    std::string meshTag;
+    std::string materialTag;
+    std::string renderLayer;
+
+    std::optional<glm::vec2> scale;
+    std::optional<glm::vec4> color;
+
+    //called once per instance since colliders are owned by their object
+    std::function<std::unique_ptr<Collider>(Object*)> colliderFactory;
+    std::string collisionGroup;
+    std::vector<std::string> collidesWith;
+
+    std::string spriteSheetTag;
+    float frameTime = 0.1f;
+    bool loopAnimation = true;
+    std::string animationClip;
+
+    std::optional<UpdatePolicy> updatePolicy;
+    uint32_t updateInterval = 1;
+};
@@ -6,6 +6,7 @@
 #include <array>
 
 #include "Debug.h"
+#include "StringID.h"
 
 class RenderLayerManager
 {
@@ -14,6 +15,11 @@ public:
     static constexpr uint8_t MAX_LAYERS = 16;
 
     [[nodiscard]] std::optional<uint8_t> GetLayerID(const std::string& name) const
+    {
+        return GetLayerID(StringID(name));
+    }
+
+    [[nodiscard]] std::optional<uint8_t> GetLayerID(StringID name) const
     {
         auto it = nameToID.find(name);
         if (it != nameToID.end())
@@ -26,10 +32,14 @@ public:
         return idToName.at(id);
     }
 
+    //bumped on every register/unregister so cached layer ids know when to resolve again
+    [[nodiscard]] uint32_t GetVersion() const { return version; }
+
 private:
     [[maybe_unused]] bool RegisterLayer(const std::string& tag, uint8_t layer)
     {
-        if (nameToID.find(tag) != nameToID.end())
+        const StringID tagID = StringID::Intern(tag);
+        if (nameToID.find(tagID) != nameToID.end())
         {
             SNAKE_WRN("Layer already exists: " << tag);
             return false;
@@ -41,14 +51,15 @@ private:
             return false;
         }
 
-        nameToID[tag] = layer;
+        nameToID[tagID] = layer;
         idToName[layer] = tag;
+        ++version;
         return true;
     }
 
     void UnregisterLayer(const std::string& name)
     {
-        auto it = nameToID.find(name);
+        auto it = nameToID.find(StringID(name));
         if (it == nameToID.end())
         {
             SNAKE_LOG("Cannot unregister: layer '" << name << "' not found");
@@ -58,7 +69,9 @@ private:
         uint8_t id = it->second;
         nameToID.erase(it);
         idToName[id].clear();
+        ++version;
     }
-    std::unordered_map<std::string, uint8_t> nameToID;
+    std::unordered_map<StringID, uint8_t> nameToID;
     std::array<std::string, MAX_LAYERS> idToName;
+    uint32_t version = 0;
 };
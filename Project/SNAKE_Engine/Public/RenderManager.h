@@ -11,12 +11,16 @@
 #include "Animation.h"
 #include "Material.h"
 #include "Mesh.h"
+#include "MeshArena.h"
 #include "Shader.h"
 #include "Texture.h"
 #include "Camera2D.h"
 #include "Font.h"
+#include "GlyphAtlas.h"
+#include "GlyphRasterizer.h"
 #include "GameObject.h"
 #include "InstanceBatchKey.h"
+#include "ObjectComponentStore.h"
 #include "RenderLayerManager.h"
 
 struct TextInstance;
@@ -28,7 +32,16 @@ using UniformName = std::string;
 using FilePath = std::string;
 using RenderCommand = std::function<void()>;
 
-using ShaderMap = std::map<Shader*, std::map<InstanceBatchKey, std::vector<std::pair<Object*, Camera2D*>>>>;
+//store is set when the object was submitted from a component store; its row then feeds instance packing directly
+struct RenderItem
+{
+    Object* object = nullptr;
+    Camera2D* camera = nullptr;
+    ObjectComponentStore* store = nullptr;
+    uint32_t row = ComponentRow::INVALID_INDEX;
+};
+
+using ShaderMap = std::map<Shader*, std::map<InstanceBatchKey, std::vector<RenderItem>>>;
 using RenderMap = std::array<ShaderMap, RenderLayerManager::MAX_LAYERS>;
 
 struct LineInstance
@@ -44,6 +57,7 @@ class RenderManager
     friend ObjectManager;
     friend StateManager;
     friend SNAKE_Engine;
+    friend Font;
 
 public:
     void RegisterShader(const std::string& tag, const std::vector<std::pair<ShaderStage, FilePath>>& sources);
@@ -54,7 +68,7 @@ public:
 
     void RegisterTexture(const std::string& tag, std::unique_ptr<Texture> texture);
 
-    void RegisterMesh(const std::string& tag, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices = {}, PrimitiveType primitiveType = PrimitiveType::Triangles);
+    void RegisterMesh(const std::string& tag, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices = {}, PrimitiveType primitiveType = PrimitiveType::Triangles, const VertexLayout& layout = {});
 
     void RegisterMesh(const std::string& tag, std::unique_ptr<Mesh> mesh);
 
@@ -87,16 +101,28 @@ public:
 
     [[nodiscard]] Shader* GetShaderByTag(const std::string& tag);
 
+    [[nodiscard]] Shader* GetShaderByTag(StringID tag);
+
     [[nodiscard]] Texture* GetTextureByTag(const std::string& tag);
 
+    [[nodiscard]] Texture* GetTextureByTag(StringID tag);
+
     [[nodiscard]] Mesh* GetMeshByTag(const std::string& tag);
 
+    [[nodiscard]] Mesh* GetMeshByTag(StringID tag);
+
     [[nodiscard]] Material* GetMaterialByTag(const std::string& tag);
 
+    [[nodiscard]] Material* GetMaterialByTag(StringID tag);
+
     [[nodiscard]] Font* GetFontByTag(const std::string& tag);
 
+    [[nodiscard]] Font* GetFontByTag(StringID tag);
+
     SpriteSheet* GetSpriteSheetByTag(const std::string& tag);
 
+    SpriteSheet* GetSpriteSheetByTag(StringID tag);
+
     void FlushDrawCommands(const EngineContext& engineContext);
 
     void SetViewport(int x, int y, int width, int height);
@@ -111,16 +137,32 @@ private:
 
     void BuildRenderMap(const std::vector<Object*>& source, Camera2D* camera);
 
+    void BuildRenderMap(ObjectComponentStore& store, const std::vector<uint32_t>& rows, Camera2D* camera);
+
     void Submit(const std::vector<Object*>& objects, const EngineContext& engineContext);
 
+    void Submit(ObjectComponentStore& store, const EngineContext& engineContext);
+
+    //frustum culls store ahead of time; the next Submit of the same store and camera reuses the result
+    void PrepareSubmit(ObjectComponentStore& store, const EngineContext& engineContext);
+
     void FlushDebugLineDrawCommands(const EngineContext& engineContext);
 
-    std::unordered_map<std::string, std::unique_ptr<Shader>> shaderMap;
-    std::unordered_map<std::string, std::unique_ptr<Texture>> textureMap;
-    std::unordered_map<std::string, std::unique_ptr<Mesh>> meshMap;
-    std::unordered_map<std::string, std::unique_ptr<Material>> materialMap;
-    std::unordered_map<std::string, std::unique_ptr<Font>> fontMap;
-    std::unordered_map<std::string, std::unique_ptr<SpriteSheet>> spritesheetMap;
+    void UploadPendingGlyphs();
+
+    [[nodiscard]] MeshArena& GetMeshArena(const VertexLayout& layout);
+
+    GlyphRasterizer glyphRasterizer;
+    std::vector<RasterizedGlyph> rasterizedGlyphs;
+    GlyphAtlas glyphAtlas;
+    std::unordered_map<VertexLayout, std::unique_ptr<MeshArena>> meshArenas;
+
+    std::unordered_map<StringID, std::unique_ptr<Shader>> shaderMap;
+    std::unordered_map<StringID, std::unique_ptr<Texture>> textureMap;
+    std::unordered_map<StringID, std::unique_ptr<Mesh>> meshMap;
+    std::unordered_map<StringID, std::unique_ptr<Material>> materialMap;
+    std::unordered_map<StringID, std::unique_ptr<Font>> fontMap;
+    std::unordered_map<StringID, std::unique_ptr<SpriteSheet>> spritesheetMap;
 
 
     using CameraAndWidth = std::pair<Camera2D*, float>;
@@ -141,6 +183,9 @@ private:
 
     RenderMap renderMap;
     RenderLayerManager renderLayerManager;
+    std::vector<uint32_t> visibleRows;
+    ObjectComponentStore* preparedStore = nullptr;
+    Camera2D* preparedCamera = nullptr;
 
     Texture* errorTexture;
 };
@@ -152,4 +197,7 @@ class FrustumCuller
 public:
     static void CullVisible(const Camera2D& camera, const std::vector<Object*>& allObjects,
         std::vector<Object*>& outVisibleList, glm::vec2 viewportSize);
+
+    static void CullVisible(const Camera2D& camera, const ObjectComponentStore& store,
+        std::vector<uint32_t>& outVisibleRows, glm::vec2 viewportSize);
 };
@@ -1,5 +1,6 @@
 #pragma once
 #include "EngineContext.h"
+#include "FrameTaskGraph.h"
 
 class SNAKE_Engine
 {
@@ -17,17 +18,25 @@ public:
     void RenderDebugDraws(bool shouldShow) { showDebugDraw = shouldShow; }
 
     [[nodiscard]] bool ShouldRenderDebugDraws() const { return showDebugDraw; }
+
+    //stage timings of the last frame are available through GetTimings/LogTimings
+    [[nodiscard]] const FrameTaskGraph& GetFrameTaskGraph() const { return frameTaskGraph; }
 private:
     void Free() const;
 
     void SetEngineContext();
 
+    void BuildFrameTaskGraph();
+
     EngineContext engineContext;
     StateManager stateManager;
     WindowManager windowManager;
     InputManager inputManager;
     RenderManager renderManager;
     SoundManager soundManager;
+    JobSystem jobSystem;
+    FrameTaskGraph frameTaskGraph;
+    float frameDeltaTime = 0.f;
     bool shouldRun = true;
     bool showDebugDraw = false;
 };
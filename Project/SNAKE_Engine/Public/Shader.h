@@ -1,9 +1,12 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "glm.hpp"
 
+#include "StringID.h"
+
 enum class ShaderStage
 {
     Vertex,
@@ -43,6 +46,21 @@ public:
 
     void SendUniform(const std::string& name, const glm::mat4& value) const;
 
+    void SendUniform(StringID name, int value) const;
+
+    void SendUniform(StringID name, float value) const;
+
+    void SendUniform(StringID name, const glm::vec2& value) const;
+
+    void SendUniform(StringID name, const glm::vec3& value) const;
+
+    void SendUniform(StringID name, const glm::vec4& value) const;
+
+    void SendUniform(StringID name, const glm::mat4& value) const;
+
+    //-1 when the linked program has no active uniform with that name
+    [[nodiscard]] GLint GetUniformLocation(StringID name) const;
+
     [[nodiscard]] GLuint GetProgramID() const { return programID; }
 
 private:
@@ -64,9 +82,12 @@ private:
 
     void CheckSupportsInstancing();
 
+    void CacheUniformLocations();
+
     GLuint programID;
     std::vector<GLuint> attachedShaders;
     std::vector<ShaderStage> attachedStages;
+    std::unordered_map<StringID, GLint> uniformLocations;
 
     bool isSupportInstancing;
 };
@@ -17,6 +17,12 @@ private:
 
     void Update(float dt, const EngineContext& engineContext);
 
+    void CheckCollision(const EngineContext& engineContext);
+
+    void LateUpdate(float dt, const EngineContext& engineContext);
+
+    void PrepareDraw(const EngineContext& engineContext);
+
     void Draw(const EngineContext& engineContext);
 
     void Free(const EngineContext& engineContext);
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+//64-bit FNV-1a hash of a name; compares and hashes as an integer
+class StringID
+{
+public:
+    constexpr StringID() = default;
+
+    //hash only, so lookups by name stay lock-free; names are interned where they are registered
+    explicit constexpr StringID(std::string_view str) : hash(Hash(str)) {}
+
+    //also records the name for GetString() and reports hash collisions; takes the registry lock
+    [[nodiscard]] static StringID Intern(std::string_view str);
+
+    [[nodiscard]] static constexpr uint64_t Hash(std::string_view str)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (char c : str)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    [[nodiscard]] static constexpr StringID FromHash(uint64_t hash_)
+    {
+        StringID id;
+        id.hash = hash_;
+        return id;
+    }
+
+    [[nodiscard]] constexpr uint64_t GetHash() const { return hash; }
+
+    [[nodiscard]] constexpr bool IsValid() const { return hash != 0; }
+
+    //falls back to the hex hash for names that were never interned
+    [[nodiscard]] std::string GetString() const;
+
+    constexpr bool operator==(const StringID& other) const { return hash == other.hash; }
+    constexpr bool operator!=(const StringID& other) const { return hash != other.hash; }
+    constexpr bool operator<(const StringID& other) const { return hash < other.hash; }
+
+private:
+    uint64_t hash = 0;
+};
+
+consteval StringID operator""_sid(const char* str, size_t length)
+{
+    return StringID::FromHash(StringID::Hash(std::string_view(str, length)));
+}
+
+namespace std
+{
+    template<>
+    struct hash<StringID>
+    {
+        std::size_t operator()(const StringID& id) const noexcept
+        {
+            return static_cast<std::size_t>(id.GetHash());
+        }
+    };
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "BroadPhase.h"
+
+//sorts the bounds along the axis with the larger spread and sweeps once. While the object count and axis
+//stay the same last frame's order is the starting guess, so the insertion sort only moves what overtook a neighbour
+class SweepAndPrune : public BroadPhase
+{
+public:
+    [[nodiscard]] BroadPhaseType GetType() const override { return BroadPhaseType::SweepAndPrune; }
+
+    void BeginFrame() override;
+
+    void Insert(Object* obj, const glm::vec2& boundsMin, const glm::vec2& boundsMax) override;
+
+    void Build() override;
+
+    void ComputePairs(std::vector<BroadPhasePair>& outPairs) override;
+
+    void QueryAABB(const glm::vec2& boundsMin, const glm::vec2& boundsMax, std::vector<Object*>& outObjects) override;
+
+    void Reset() override;
+
+private:
+    struct Entry
+    {
+        Object* object;
+        glm::vec2 boundsMin;
+        glm::vec2 boundsMax;
+    };
+
+    void SortAlongAxis(int axis);
+
+    std::vector<Entry> entries;
+    //entry indices sorted by boundsMin on sortAxis
+    std::vector<uint32_t> order;
+    int sortAxis = 0;
+    //order matches entries only between Build and the next BeginFrame
+    bool isSorted = false;
+};
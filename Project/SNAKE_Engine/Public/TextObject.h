@@ -1,6 +1,6 @@
 #pragma once
 #include "EngineContext.h"
-#include "Mesh.h"
+#include "DynamicMesh.h"
 #include "Object.h"
 #include "Transform.h"
 
@@ -78,7 +78,11 @@ protected:
     TextAlignV alignV;
 
     TextInstance textInstance;
-    std::unique_ptr<Mesh> textMesh;
+    std::unique_ptr<DynamicMesh> textMesh;
+    std::vector<Vertex> textVertices;
+    std::vector<unsigned int> textIndices;
 
     int textAtlasVersionTracker = 0;
+    int textGlyphVersionTracker = 0;
+    bool hasPendingGlyphs = false;
 };
@@ -1,8 +1,16 @@
 #pragma once
 #include "glm.hpp"
 
+#include "ObjectComponentStore.h"
+
+class Object;
+class ObjectManager;
+
 class Transform2D
 {
+    friend Object;
+    friend ObjectComponentStore;
+    friend ObjectManager;
 public:
     Transform2D()
         : position(0.f), rotation(0.f), scale(1.f),
@@ -10,51 +18,89 @@ public:
     {
     }
 
+    //a copy takes the values but never the store row, so it cannot alias another object's row
+    Transform2D(const Transform2D& other)
+        : position(other.GetPosition()), rotation(other.GetRotation()), scale(other.GetScale()),
+        matrix(1.f), isChanged(true)
+    {
+    }
+
+    //writes the values into this transform, which keeps its own row
+    Transform2D& operator=(const Transform2D& other)
+    {
+        if (this != &other)
+        {
+            PositionRef() = other.GetPosition();
+            RotationRef() = other.GetRotation();
+            ScaleRef() = other.GetScale();
+            MarkChanged();
+        }
+        return *this;
+    }
+
     void SetPosition(const glm::vec2& pos)
     {
-        position = pos;
-        isChanged = true;
+        PositionRef() = pos;
+        MarkChanged();
     }
 
     void AddPosition(const glm::vec2& pos)
     {
-        position += pos;
-        isChanged = true;
+        PositionRef() += pos;
+        MarkChanged();
     }
 
     void SetRotation(float rot)
     {
-        rotation = rot;
-        isChanged = true;
+        RotationRef() = rot;
+        MarkChanged();
     }
 
     void AddRotation(float rot)
     {
-        rotation += rot;
-        isChanged = true;
+        RotationRef() += rot;
+        MarkChanged();
     }
 
     void SetScale(const glm::vec2& scl)
     {
-        scale = scl;
-        isChanged = true;
+        ScaleRef() = scl;
+        MarkChanged();
     }
 
     void AddScale(const glm::vec2& scl)
     {
-        scale += scl;
-        isChanged = true;
+        ScaleRef() += scl;
+        MarkChanged();
     }
 
-    [[nodiscard]] const glm::vec2& GetPosition() const { return position; }
+    //returned by value: a store row moves when other rows are bound or removed
+    [[nodiscard]] glm::vec2 GetPosition() const { return row.store ? row.store->positions[row.index] : position; }
 
-    [[nodiscard]] float GetRotation() const { return rotation; }
+    [[nodiscard]] float GetRotation() const { return row.store ? row.store->rotations[row.index] : rotation; }
 
-    [[nodiscard]] const glm::vec2& GetScale() const { return scale; }
+    [[nodiscard]] glm::vec2 GetScale() const { return row.store ? row.store->scales[row.index] : scale; }
 
-    [[nodiscard]] glm::mat4& GetMatrix();
+    [[nodiscard]] glm::mat4 GetMatrix();
 
 private:
+    //while bound the component store owns the values and the members below are only a parked copy
+    [[nodiscard]] glm::vec2& PositionRef() { return row.store ? row.store->positions[row.index] : position; }
+    [[nodiscard]] float& RotationRef() { return row.store ? row.store->rotations[row.index] : rotation; }
+    [[nodiscard]] glm::vec2& ScaleRef() { return row.store ? row.store->scales[row.index] : scale; }
+
+    void MarkChanged()
+    {
+        if (row.store)
+        {
+            row.store->matrixDirty[row.index] = 1;
+            row.store->colliderDirty[row.index] = 1;
+        }
+        else
+            isChanged = true;
+    }
+
+    ComponentRow row;
     glm::vec2 position;
     float rotation;
     glm::vec2 scale;
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "glm.hpp"
+
+using GLuint = unsigned int;
+using GLsizei = int;
+
+struct Vertex
+{
+    glm::vec3 position;
+    glm::vec2 uv;
+    glm::vec4 color = glm::vec4(1.0f);
+};
+
+enum class VertexPositionFormat
+{
+    Float2,
+    Float3
+};
+
+enum class VertexUVFormat
+{
+    Float2,
+    Half2,
+    UNorm16x2
+};
+
+struct VertexLayout
+{
+    VertexPositionFormat position = VertexPositionFormat::Float3;
+    VertexUVFormat uv = VertexUVFormat::Float2;
+    //packed as 4 x unorm8 at attribute location 9
+    bool hasColor = false;
+
+    static constexpr GLuint COLOR_LOCATION = 9;
+
+    [[nodiscard]] GLsizei GetStride() const;
+
+    [[nodiscard]] GLuint GetUVOffset() const;
+
+    [[nodiscard]] GLuint GetColorOffset() const;
+
+    void SetupAttributes(GLuint vao, GLuint vbo) const;
+
+    void PackVertices(const std::vector<Vertex>& vertices, std::vector<unsigned char>& out) const;
+
+    void PackVertices(const Vertex* vertices, size_t count, std::vector<unsigned char>& out) const;
+
+    //returns true when the indices were narrowed to 16 bits
+    static bool PackIndices(const std::vector<unsigned int>& indices, size_t vertexCount, std::vector<unsigned char>& out);
+
+    bool operator==(const VertexLayout& other) const
+    {
+        return position == other.position && uv == other.uv && hasColor == other.hasColor;
+    }
+};
+
+namespace std
+{
+    template<>
+    struct hash<VertexLayout>
+    {
+        std::size_t operator()(const VertexLayout& layout) const noexcept
+        {
+            return static_cast<std::size_t>(layout.position) | (static_cast<std::size_t>(layout.uv) << 2) | (static_cast<std::size_t>(layout.hasColor) << 4);
+        }
+    };
+}